@@ -2,9 +2,15 @@
 #define DOUBLE_SENTINEL_LIST_H
 
 #include <iostream>
+#include <new>
+#include <utility>
 #include "Exception.h"
+#include "Node_pool.h"
 
-template <typename Type>
+// The nodes are allocated by Allocator, by default a Node_pool owned by the list, which carves
+// them out of large chunks and releases the chunks all at once when the list is destroyed;
+// Heap_allocator gives each node its own heap allocation instead
+template <typename Type, template <typename> class Allocator = Node_pool>
 class Double_sentinel_list {
 	public:
 		class Double_node {
@@ -55,27 +61,35 @@ class Double_sentinel_list {
 
 		int erase( Type const & );
 
+		void move_to_front( Double_node * );
+		void erase_node( Double_node * );
+
 	private:
+		// Declared first, so that the sentinels can be allocated from it
+		Allocator<Double_node> nodes;
 		Double_node *list_head;
 		Double_node *list_tail;
 		int list_size;
 
 		// List any additional private member functions you author here
+		Double_node *create_node( Type const & = Type(), Double_node * = nullptr, Double_node * = nullptr );
+		void destroy_node( Double_node * );
 	// Friends
 
-	template <typename T>
-	friend std::ostream &operator<<( std::ostream &, Double_sentinel_list<T> const & );
+	template <typename T, template <typename> class A>
+	friend std::ostream &operator<<( std::ostream &, Double_sentinel_list<T, A> const & );
 };
 
 /////////////////////////////////////////////////////////////////////////
 //                      Public member functions                        //
 /////////////////////////////////////////////////////////////////////////
 
-template <typename Type>
-Double_sentinel_list<Type>::Double_sentinel_list():
+template <typename Type, template <typename> class Allocator>
+Double_sentinel_list<Type, Allocator>::Double_sentinel_list():
 // Updated the initialization list here
-list_head( new Double_node() ),
-list_tail( new Double_node() ),
+nodes(),
+list_head( create_node() ),
+list_tail( create_node() ),
 list_size( 0 )
 {
 	//The empty constructors makes two sentinel nodes that point to each other since the list is empty
@@ -83,27 +97,31 @@ list_size( 0 )
 	list_tail->previous_node = list_head;
 }
 
-template <typename Type>
-Double_sentinel_list<Type>::Double_sentinel_list( Double_sentinel_list<Type> const &list ):
+template <typename Type, template <typename> class Allocator>
+Double_sentinel_list<Type, Allocator>::Double_sentinel_list( Double_sentinel_list<Type, Allocator> const &list ):
 // Updated the initialization list here
-list_head( new Double_node() ),
-list_tail( new Double_node() ),
+nodes(),
+list_head( create_node() ),
+list_tail( create_node() ),
 list_size( 0 )
 {
 	//The copy constructor copies the values of argument list without copying their addresses
 	//push_back() is used so that the same order will remain
+	//The storage for all the nodes is reserved first, so the allocator can provide it in one request
     list_head->next_node = list_tail;
+    nodes.reserve(list.size());
     list_tail->previous_node = list_head;
     for(Double_node * ptr = list.begin(); ptr != list.end(); ptr = ptr->next()){
         push_back(ptr->value());
     }
 }
 
-template <typename Type>
-Double_sentinel_list<Type>::Double_sentinel_list( Double_sentinel_list<Type> &&list ):
+template <typename Type, template <typename> class Allocator>
+Double_sentinel_list<Type, Allocator>::Double_sentinel_list( Double_sentinel_list<Type, Allocator> &&list ):
 // Updated the initialization list here
-list_head( new Double_node() ),
-list_tail( new Double_node() ),
+nodes(),
+list_head( create_node() ),
+list_tail( create_node() ),
 list_size( 0 )
 {
 	//The move constructor simply calls swap() on the argument list
@@ -113,30 +131,30 @@ list_size( 0 )
 	swap(list);
 }
 
-template <typename Type>
-Double_sentinel_list<Type>::~Double_sentinel_list() {
+template <typename Type, template <typename> class Allocator>
+Double_sentinel_list<Type, Allocator>::~Double_sentinel_list() {
 	//This function continuously deletes the front node until all elements are deleted and then deletes the memory
 	//allocated for the sentinels
 	while(!empty())
         pop_front();
-    delete rend();
-    delete end();
+    destroy_node(rend());
+    destroy_node(end());
 }
 
-template <typename Type>
-int Double_sentinel_list<Type>::size() const {
+template <typename Type, template <typename> class Allocator>
+int Double_sentinel_list<Type, Allocator>::size() const {
 	//simply return the number of nodes in the list excluding sentinels
 	return list_size;
 }
 
-template <typename Type>
-bool Double_sentinel_list<Type>::empty() const {
+template <typename Type, template <typename> class Allocator>
+bool Double_sentinel_list<Type, Allocator>::empty() const {
 	//returns whether the list has no nodes excluding sentinels
 	return list_size == 0;
 }
 
-template <typename Type>
-Type Double_sentinel_list<Type>::front() const {
+template <typename Type, template <typename> class Allocator>
+Type Double_sentinel_list<Type, Allocator>::front() const {
 	//This function returns the value of the first node that is not a sentinel.
 	//If the list is empty, it throws an exception
 	if(empty())
@@ -145,8 +163,8 @@ Type Double_sentinel_list<Type>::front() const {
 	return begin()->value(); //
 }
 
-template <typename Type>
-Type Double_sentinel_list<Type>::back() const {
+template <typename Type, template <typename> class Allocator>
+Type Double_sentinel_list<Type, Allocator>::back() const {
 	//Similar to front(): returns the value of the last node that is not a sentinel.
 	//Also throws exception for an empty list.
 	if(empty())
@@ -154,32 +172,32 @@ Type Double_sentinel_list<Type>::back() const {
 	return rbegin()->value(); //
 }
 
-template <typename Type>
-typename Double_sentinel_list<Type>::Double_node *Double_sentinel_list<Type>::begin() const {
+template <typename Type, template <typename> class Allocator>
+typename Double_sentinel_list<Type, Allocator>::Double_node *Double_sentinel_list<Type, Allocator>::begin() const {
 	//Returns the pointer to the first object in the list that is not a sentinel
 	return list_head->next();
 }
 
-template <typename Type>
-typename Double_sentinel_list<Type>::Double_node *Double_sentinel_list<Type>::end() const {
+template <typename Type, template <typename> class Allocator>
+typename Double_sentinel_list<Type, Allocator>::Double_node *Double_sentinel_list<Type, Allocator>::end() const {
 	//Returns the pointer to the tail sentinel
 	return list_tail;
 }
 
-template <typename Type>
-typename Double_sentinel_list<Type>::Double_node *Double_sentinel_list<Type>::rbegin() const {
+template <typename Type, template <typename> class Allocator>
+typename Double_sentinel_list<Type, Allocator>::Double_node *Double_sentinel_list<Type, Allocator>::rbegin() const {
 	//Returns the pointer to the last object in the list that is not a sentinel
 	return list_tail->previous();
 }
 
-template <typename Type>
-typename Double_sentinel_list<Type>::Double_node *Double_sentinel_list<Type>::rend() const {
+template <typename Type, template <typename> class Allocator>
+typename Double_sentinel_list<Type, Allocator>::Double_node *Double_sentinel_list<Type, Allocator>::rend() const {
 	//Returns the address of the head sentinel
 	return list_head;
 }
 
-template <typename Type>
-typename Double_sentinel_list<Type>::Double_node *Double_sentinel_list<Type>::find( Type const &obj ) const {
+template <typename Type, template <typename> class Allocator>
+typename Double_sentinel_list<Type, Allocator>::Double_node *Double_sentinel_list<Type, Allocator>::find( Type const &obj ) const {
 	//Checks for the first found instance of the argument object in the list and returns its address.
 	//Returns a nullpointer if the object is not in the list.
 	for(Double_node * ptr = begin(); ptr != end(); ptr = ptr->next()){
@@ -189,8 +207,8 @@ typename Double_sentinel_list<Type>::Double_node *Double_sentinel_list<Type>::fi
 	return end();
 }
 
-template <typename Type>
-int Double_sentinel_list<Type>::count( Type const &obj ) const {
+template <typename Type, template <typename> class Allocator>
+int Double_sentinel_list<Type, Allocator>::count( Type const &obj ) const {
 	//Counts the occurences of the argument object in the list and returns the count.
 	int count = 0;
 	for(Double_node * ptr = begin(); ptr != end(); ptr = ptr->next()){
@@ -200,17 +218,19 @@ int Double_sentinel_list<Type>::count( Type const &obj ) const {
 	return count;
 }
 
-template <typename Type>
-void Double_sentinel_list<Type>::swap( Double_sentinel_list<Type> &list ) {
+template <typename Type, template <typename> class Allocator>
+void Double_sentinel_list<Type, Allocator>::swap( Double_sentinel_list<Type, Allocator> &list ) {
 	//Simply swaps the node member variables with the one in the argument list
+	//The allocators are swapped as well, since each list's nodes live in its own allocator
 	std::swap( this->list_head, list.list_head );
 	std::swap( this->list_tail, list.list_tail );
 	std::swap( this->list_size, list.list_size );
+	nodes.swap( list.nodes );
 }
 
 // The assignment operator
-template <typename Type>
-Double_sentinel_list<Type> &Double_sentinel_list<Type>::operator=( Double_sentinel_list<Type> rhs ) {
+template <typename Type, template <typename> class Allocator>
+Double_sentinel_list<Type, Allocator> &Double_sentinel_list<Type, Allocator>::operator=( Double_sentinel_list<Type, Allocator> rhs ) {
 	// This is done for you
 	swap( rhs );
 
@@ -218,41 +238,41 @@ Double_sentinel_list<Type> &Double_sentinel_list<Type>::operator=( Double_sentin
 }
 
 // The move operator
-template <typename Type>
-Double_sentinel_list<Type> &Double_sentinel_list<Type>::operator=( Double_sentinel_list<Type> &&rhs ) {
+template <typename Type, template <typename> class Allocator>
+Double_sentinel_list<Type, Allocator> &Double_sentinel_list<Type, Allocator>::operator=( Double_sentinel_list<Type, Allocator> &&rhs ) {
 	// This is done for you
 	swap( rhs );
 
 	return *this;
 }
 
-template <typename Type>
-void Double_sentinel_list<Type>::push_front( Type const &obj ) {
+template <typename Type, template <typename> class Allocator>
+void Double_sentinel_list<Type, Allocator>::push_front( Type const &obj ) {
 	//Allocates new memory for a Double_node at the front of the list
 	//Assigns the argument object as its value,
 	//the head_sentinel as the previous pointer, and the current front object as its next node.
 	//The current front node's previous_node value is changed first as it uses begin(), which
 	//requires the head sentinel's next pointer to point to the current front node.
-	Double_node * newFrontNode = new Double_node(obj, rend(), begin());
+	Double_node * newFrontNode = create_node(obj, rend(), begin());
 	begin()->previous_node = newFrontNode;
 	rend()->next_node = newFrontNode;
     list_size++;
 }
 
-template <typename Type>
-void Double_sentinel_list<Type>::push_back( Type const &obj ) {
+template <typename Type, template <typename> class Allocator>
+void Double_sentinel_list<Type, Allocator>::push_back( Type const &obj ) {
 	//Allocates new memory for a Double_node at the back of the list
 	//Assigns the argument object as its value,
 	//the last object as the previous pointer, and the current tail_sentinel as its next node.
 	//The current tail node's next_node value is changed first as it uses rbegin(), which
 	//requires the tail sentinel's previous pointer to point to the current tail node.
-	Double_node * newBackNode = new Double_node(obj, rbegin(), end());
+	Double_node * newBackNode = create_node(obj, rbegin(), end());
 	rbegin()->next_node = newBackNode;
 	end()->previous_node = newBackNode;
     list_size++;
 }
-template <typename Type>
-void Double_sentinel_list<Type>::pop_front() {
+template <typename Type, template <typename> class Allocator>
+void Double_sentinel_list<Type, Allocator>::pop_front() {
 	//Deletes the object at the front of the list if the list has at least 1 object; otherwise,
 	//it throws an exception.
 	//The head sentinel's next_node is set to point at the object after the one that is to be deleted
@@ -262,11 +282,11 @@ void Double_sentinel_list<Type>::pop_front() {
 	Double_node * toPop = begin();
     begin()->next()->previous_node = rend();    //object after pop points back to head sentinel
 	rend()->next_node = begin()->next();    //head sentinel now points to object after toPop
-	delete toPop;
+	destroy_node(toPop);
     list_size--;
 }
-template <typename Type>
-void Double_sentinel_list<Type>::pop_back() {
+template <typename Type, template <typename> class Allocator>
+void Double_sentinel_list<Type, Allocator>::pop_back() {
 	//Deletes the object at the back of the list if the list has at least 1 object; otherwise,
 	//it throws an exception.
 	//The tail sentinel's previous_node is set to point at the object before the one that is to be deleted
@@ -276,11 +296,11 @@ void Double_sentinel_list<Type>::pop_back() {
     Double_node * toPop = rbegin();
     rbegin()->previous()->next_node = end();
     end()->previous_node = rbegin()->previous();
-    delete toPop;
+    destroy_node(toPop);
     list_size--;
 }
-template <typename Type>
-int Double_sentinel_list<Type>::erase( Type const &obj ) {
+template <typename Type, template <typename> class Allocator>
+int Double_sentinel_list<Type, Allocator>::erase( Type const &obj ) {
 	//Deletes all nodes whose value matches that of the argument value.
 	//A while loop is used as opposed to a for loop to allow the intended pointers to be deleted after the
 	//traverse pointer has been updates as to avoid memory errors.
@@ -294,7 +314,7 @@ int Double_sentinel_list<Type>::erase( Type const &obj ) {
 			ptr = ptr->next();
 			countDeleted++;
 			list_size--;
-			delete toPop;
+			destroy_node(toPop);
 		}
 		else
 			ptr = ptr->next();
@@ -302,11 +322,37 @@ int Double_sentinel_list<Type>::erase( Type const &obj ) {
 	return countDeleted;
 }
 
-template <typename Type>
-Double_sentinel_list<Type>::Double_node::Double_node(
+template <typename Type, template <typename> class Allocator>
+void Double_sentinel_list<Type, Allocator>::move_to_front( Double_node *node ) {
+	//Relinks a node of this list, found for example through find() or kept from begin() after a push,
+	//at the front of the list in O(1). The node is not copied, so pointers to it stay valid.
+	if(node == begin())
+		return;
+	node->previous()->next_node = node->next();
+	node->next()->previous_node = node->previous();
+	node->previous_node = rend();
+	node->next_node = begin();
+	begin()->previous_node = node;
+	rend()->next_node = node;
+}
+
+template <typename Type, template <typename> class Allocator>
+void Double_sentinel_list<Type, Allocator>::erase_node( Double_node *node ) {
+	//Deletes one node of this list in O(1), without searching for it.
+	//Passing a sentinel is an error, so it throws an exception.
+	if(node == rend() || node == end())
+		throw illegal_argument();
+	node->previous()->next_node = node->next();
+	node->next()->previous_node = node->previous();
+	destroy_node(node);
+	list_size--;
+}
+
+template <typename Type, template <typename> class Allocator>
+Double_sentinel_list<Type, Allocator>::Double_node::Double_node(
 	Type const &nv,
-	typename Double_sentinel_list<Type>::Double_node *pn,
-	typename Double_sentinel_list<Type>::Double_node *nn ):
+	typename Double_sentinel_list<Type, Allocator>::Double_node *pn,
+	typename Double_sentinel_list<Type, Allocator>::Double_node *nn ):
 //Assigns the proper argument variables to the proper member variables
 node_value( nv ),
 previous_node( pn ),
@@ -315,20 +361,20 @@ next_node( nn )
 	//empty constructor
 }
 
-template <typename Type>
-Type Double_sentinel_list<Type>::Double_node::value() const {
+template <typename Type, template <typename> class Allocator>
+Type Double_sentinel_list<Type, Allocator>::Double_node::value() const {
 	//Returns the value stored by the node
 	return node_value;
 }
 
-template <typename Type>
-typename Double_sentinel_list<Type>::Double_node *Double_sentinel_list<Type>::Double_node::previous() const {
+template <typename Type, template <typename> class Allocator>
+typename Double_sentinel_list<Type, Allocator>::Double_node *Double_sentinel_list<Type, Allocator>::Double_node::previous() const {
 	//Returns the pointer to the previous node
 	return previous_node;
 }
 
-template <typename Type>
-typename Double_sentinel_list<Type>::Double_node *Double_sentinel_list<Type>::Double_node::next() const {
+template <typename Type, template <typename> class Allocator>
+typename Double_sentinel_list<Type, Allocator>::Double_node *Double_sentinel_list<Type, Allocator>::Double_node::next() const {
 	//Returns the pointer to the next node
 	return next_node;
 }
@@ -339,17 +385,33 @@ typename Double_sentinel_list<Type>::Double_node *Double_sentinel_list<Type>::Do
 
 // If you author any additional private member functions, include them here
 
+template <typename Type, template <typename> class Allocator>
+typename Double_sentinel_list<Type, Allocator>::Double_node *Double_sentinel_list<Type, Allocator>::create_node(
+	Type const &nv,
+	Double_node *pn,
+	Double_node *nn ) {
+	//Constructs a node in storage from the allocator
+	return new (nodes.allocate()) Double_node(nv, pn, nn);
+}
+
+template <typename Type, template <typename> class Allocator>
+void Double_sentinel_list<Type, Allocator>::destroy_node( Double_node *node ) {
+	//Destroys a node and gives its storage back to the allocator
+	node->~Double_node();
+	nodes.deallocate(node);
+}
+
 /////////////////////////////////////////////////////////////////////////
 //                               Friends                               //
 /////////////////////////////////////////////////////////////////////////
 
 // You can modify this function however you want:  it will not be tested
 
-template <typename T>
-std::ostream &operator<<( std::ostream &out, Double_sentinel_list<T> const &list ) {
+template <typename T, template <typename> class A>
+std::ostream &operator<<( std::ostream &out, Double_sentinel_list<T, A> const &list ) {
 	out << "head";
 
-	for ( typename Double_sentinel_list<T>::Double_node *ptr = list.rend(); ptr != nullptr; ptr = ptr->next() ) {
+	for ( typename Double_sentinel_list<T, A>::Double_node *ptr = list.rend(); ptr != nullptr; ptr = ptr->next() ) {
 		if ( ptr == list.rend() || ptr == list.end() ) {
 			out << "->S";
 		} else {
@@ -359,7 +421,7 @@ std::ostream &operator<<( std::ostream &out, Double_sentinel_list<T> const &list
 
 	out << "->0" << std::endl << "tail";
 
-	for ( typename Double_sentinel_list<T>::Double_node *ptr = list.end(); ptr != nullptr; ptr = ptr->previous() ) {
+	for ( typename Double_sentinel_list<T, A>::Double_node *ptr = list.end(); ptr != nullptr; ptr = ptr->previous() ) {
 		if ( ptr == list.rend() || ptr == list.end() ) {
 			out << "->S";
 		} else {
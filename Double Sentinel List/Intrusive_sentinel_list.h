@@ -0,0 +1,484 @@
+#ifndef INTRUSIVE_SENTINEL_LIST_H
+#define INTRUSIVE_SENTINEL_LIST_H
+
+#include <cstddef>
+#include <iostream>
+#include <iterator>
+#include <utility>
+#include "Exception.h"
+
+// An intrusive variant of Double_sentinel_list: the list links objects it does not own
+// through a hook each object carries, instead of copying them into nodes it allocates
+//
+// A type is made linkable by deriving from Intrusive_hook<Tag>:
+//     class Timer: public Intrusive_hook<> { ... };
+//     Intrusive_sentinel_list<Timer> expiring;
+// An object can be in one list per hook it has; a type that must be in two lists at once
+// derives from two hooks with different tags, for example Intrusive_hook<By_deadline>
+// and Intrusive_hook<By_connection>, and each list names the tag it links through
+//
+// The head and tail sentinels are hooks inside the list object itself, so no operation
+// allocates, and an object is unlinked in O(1) without searching for it
+// Each hook records the list it is linked into, so unlinking an object from a list it is
+// not in is caught rather than corrupting the sizes of both lists; in exchange, swap()
+// and moves take time linear in the number of objects, to update their owner
+// The objects must outlive their time in the list; destroying the list unlinks them all
+
+// The links of an object in a list, or null links if it is not in one
+// Copying an object does not copy its links: the copy starts unlinked
+template <typename Tag = void>
+class Intrusive_hook {
+	public:
+		Intrusive_hook();
+		Intrusive_hook( Intrusive_hook const & );
+		Intrusive_hook &operator=( Intrusive_hook const & );
+
+		bool is_linked() const;
+
+	private:
+		Intrusive_hook *previous_hook;
+		Intrusive_hook *next_hook;
+		void const *owner_list;
+
+		template <typename T, typename G>
+		friend class Intrusive_sentinel_list;
+};
+
+template <typename Type, typename Tag = void>
+class Intrusive_sentinel_list {
+	public:
+		typedef Intrusive_hook<Tag> Hook;
+
+		class iterator;
+
+		Intrusive_sentinel_list();
+		Intrusive_sentinel_list( Intrusive_sentinel_list && );
+		~Intrusive_sentinel_list();
+
+		// Accessors
+
+		int size() const;
+		bool empty() const;
+
+		Type &front() const;
+		Type &back() const;
+
+		iterator begin() const;
+		iterator end() const;
+
+		iterator find( Type const & ) const;
+		int count( Type const & ) const;
+
+		// Mutators
+
+		void swap( Intrusive_sentinel_list & );
+		Intrusive_sentinel_list &operator=( Intrusive_sentinel_list && );
+
+		void push_front( Type & );
+		void push_back( Type & );
+		void insert( iterator, Type & );
+
+		void pop_front();
+		void pop_back();
+
+		void unlink( Type & );
+		void clear();
+
+	private:
+		Hook list_head;
+		Hook list_tail;
+		int list_size;
+
+		static Hook *hook_of( Type & );
+		static Type &object_of( Hook * );
+		void link_before( Hook *, Type & );
+		void unlink_hook( Hook * );
+		void adopt_all();
+
+		// The list only links objects it does not own, so it is moved but never copied
+		Intrusive_sentinel_list( Intrusive_sentinel_list const & );
+		Intrusive_sentinel_list &operator=( Intrusive_sentinel_list const & );
+
+	// Friends
+
+	template <typename T, typename G>
+	friend std::ostream &operator<<( std::ostream &, Intrusive_sentinel_list<T, G> const & );
+};
+
+// A bidirectional iterator over the linked objects, front to back
+// It stays valid until its own object is unlinked
+template <typename Type, typename Tag>
+class Intrusive_sentinel_list<Type, Tag>::iterator {
+	public:
+		typedef std::bidirectional_iterator_tag iterator_category;
+		typedef Type value_type;
+		typedef std::ptrdiff_t difference_type;
+		typedef Type *pointer;
+		typedef Type &reference;
+
+		iterator():
+		hook( nullptr ) {
+			// empty constructor
+		}
+
+		explicit iterator( Hook *h ):
+		hook( h ) {
+			// empty constructor
+		}
+
+		reference operator*() const {
+		    return object_of( hook );
+		}
+
+		pointer operator->() const {
+		    return &object_of( hook );
+		}
+
+		iterator &operator++() {
+		    hook = hook->next_hook;
+		    return *this;
+		}
+
+		iterator operator++( int ) {
+		    iterator previous( *this );
+		    hook = hook->next_hook;
+		    return previous;
+		}
+
+		iterator &operator--() {
+		    hook = hook->previous_hook;
+		    return *this;
+		}
+
+		iterator operator--( int ) {
+		    iterator previous( *this );
+		    hook = hook->previous_hook;
+		    return previous;
+		}
+
+		bool operator==( iterator const &other ) const {
+		    return hook == other.hook;
+		}
+
+		bool operator!=( iterator const &other ) const {
+		    return hook != other.hook;
+		}
+
+	private:
+		Hook *hook;
+
+		friend class Intrusive_sentinel_list;
+};
+
+/////////////////////////////////////////////////////////////////////////
+//                   Constructors and Destructors                      //
+/////////////////////////////////////////////////////////////////////////
+
+template <typename Tag>
+Intrusive_hook<Tag>::Intrusive_hook():
+previous_hook( nullptr ),
+next_hook( nullptr ),
+owner_list( nullptr ) {
+	// empty constructor
+}
+
+template <typename Tag>
+Intrusive_hook<Tag>::Intrusive_hook( Intrusive_hook const & ):
+previous_hook( nullptr ),
+next_hook( nullptr ),
+owner_list( nullptr ) {
+	// empty constructor
+}
+
+// Assigning to an object keeps it in whatever list it is in
+template <typename Tag>
+Intrusive_hook<Tag> &Intrusive_hook<Tag>::operator=( Intrusive_hook const & ) {
+	return *this;
+}
+
+// Constructor
+// The two sentinels point to each other
+template <typename Type, typename Tag>
+Intrusive_sentinel_list<Type, Tag>::Intrusive_sentinel_list():
+list_head(),
+list_tail(),
+list_size( 0 ) {
+	list_head.next_hook = &list_tail;
+	list_tail.previous_hook = &list_head;
+}
+
+// Move Constructor
+template <typename Type, typename Tag>
+Intrusive_sentinel_list<Type, Tag>::Intrusive_sentinel_list( Intrusive_sentinel_list &&list ):
+list_head(),
+list_tail(),
+list_size( 0 ) {
+	list_head.next_hook = &list_tail;
+	list_tail.previous_hook = &list_head;
+	swap( list );
+}
+
+// Destructor
+// Unlinks every object, so that each can be linked into another list
+template <typename Type, typename Tag>
+Intrusive_sentinel_list<Type, Tag>::~Intrusive_sentinel_list() {
+	clear();
+}
+
+/////////////////////////////////////////////////////////////////////////
+//                      Public member functions                        //
+/////////////////////////////////////////////////////////////////////////
+
+// Return true if the object is in a list through this hook
+template <typename Tag>
+bool Intrusive_hook<Tag>::is_linked() const {
+	return owner_list != nullptr;
+}
+
+template <typename Type, typename Tag>
+int Intrusive_sentinel_list<Type, Tag>::size() const {
+	return list_size;
+}
+
+template <typename Type, typename Tag>
+bool Intrusive_sentinel_list<Type, Tag>::empty() const {
+	return list_size == 0;
+}
+
+// Return the object at the front itself, not a copy
+template <typename Type, typename Tag>
+Type &Intrusive_sentinel_list<Type, Tag>::front() const {
+	if ( empty() )
+		throw underflow();
+
+	return object_of( list_head.next_hook );
+}
+
+// Return the object at the back itself, not a copy
+template <typename Type, typename Tag>
+Type &Intrusive_sentinel_list<Type, Tag>::back() const {
+	if ( empty() )
+		throw underflow();
+
+	return object_of( list_tail.previous_hook );
+}
+
+template <typename Type, typename Tag>
+typename Intrusive_sentinel_list<Type, Tag>::iterator Intrusive_sentinel_list<Type, Tag>::begin() const {
+	return iterator( list_head.next_hook );
+}
+
+// Return an iterator to the tail sentinel
+template <typename Type, typename Tag>
+typename Intrusive_sentinel_list<Type, Tag>::iterator Intrusive_sentinel_list<Type, Tag>::end() const {
+	return iterator( const_cast<Hook *>( &list_tail ) );
+}
+
+// Return an iterator to the first object equal to the argument, or end() if there is none
+template <typename Type, typename Tag>
+typename Intrusive_sentinel_list<Type, Tag>::iterator Intrusive_sentinel_list<Type, Tag>::find( Type const &obj ) const {
+    for ( iterator it = begin(); it != end(); ++it ) {
+        if ( *it == obj )
+            return it;
+    }
+
+    return end();
+}
+
+// Return the number of objects equal to the argument
+template <typename Type, typename Tag>
+int Intrusive_sentinel_list<Type, Tag>::count( Type const &obj ) const {
+    int n = 0;
+
+    for ( iterator it = begin(); it != end(); ++it ) {
+        if ( *it == obj )
+            ++n;
+    }
+
+    return n;
+}
+
+// Exchange the objects of the two lists
+// The sentinels are part of each list object, so the end objects of each chain are
+// relinked to the other list's sentinels
+template <typename Type, typename Tag>
+void Intrusive_sentinel_list<Type, Tag>::swap( Intrusive_sentinel_list &list ) {
+    if ( this == &list )
+        return;
+
+    Hook *first = list_head.next_hook;
+    Hook *last = list_tail.previous_hook;
+    Hook *other_first = list.list_head.next_hook;
+    Hook *other_last = list.list_tail.previous_hook;
+
+    if ( list.empty() ) {
+        list_head.next_hook = &list_tail;
+        list_tail.previous_hook = &list_head;
+    } else {
+        list_head.next_hook = other_first;
+        other_first->previous_hook = &list_head;
+        list_tail.previous_hook = other_last;
+        other_last->next_hook = &list_tail;
+    }
+
+    if ( empty() ) {
+        list.list_head.next_hook = &list.list_tail;
+        list.list_tail.previous_hook = &list.list_head;
+    } else {
+        list.list_head.next_hook = first;
+        first->previous_hook = &list.list_head;
+        list.list_tail.previous_hook = last;
+        last->next_hook = &list.list_tail;
+    }
+
+    std::swap( list_size, list.list_size );
+
+    adopt_all();
+    list.adopt_all();
+}
+
+// The objects of this list are unlinked, and those of the argument take their place
+template <typename Type, typename Tag>
+Intrusive_sentinel_list<Type, Tag> &Intrusive_sentinel_list<Type, Tag>::operator=( Intrusive_sentinel_list &&rhs ) {
+	clear();
+	swap( rhs );
+
+	return *this;
+}
+
+// Link an object at the front; it must not already be in a list through this hook
+template <typename Type, typename Tag>
+void Intrusive_sentinel_list<Type, Tag>::push_front( Type &obj ) {
+	link_before( list_head.next_hook, obj );
+}
+
+// Link an object at the back; it must not already be in a list through this hook
+template <typename Type, typename Tag>
+void Intrusive_sentinel_list<Type, Tag>::push_back( Type &obj ) {
+	link_before( &list_tail, obj );
+}
+
+// Link an object just before the given position, which must be in this list or be end()
+template <typename Type, typename Tag>
+void Intrusive_sentinel_list<Type, Tag>::insert( iterator position, Type &obj ) {
+    if ( position.hook != &list_tail && position.hook->owner_list != this )
+        throw illegal_argument();
+
+    link_before( position.hook, obj );
+}
+
+// Unlink the object at the front
+template <typename Type, typename Tag>
+void Intrusive_sentinel_list<Type, Tag>::pop_front() {
+	if ( empty() )
+		throw underflow();
+
+	unlink_hook( list_head.next_hook );
+}
+
+// Unlink the object at the back
+template <typename Type, typename Tag>
+void Intrusive_sentinel_list<Type, Tag>::pop_back() {
+	if ( empty() )
+		throw underflow();
+
+	unlink_hook( list_tail.previous_hook );
+}
+
+// Unlink an object, which must be in this list, without searching for it
+template <typename Type, typename Tag>
+void Intrusive_sentinel_list<Type, Tag>::unlink( Type &obj ) {
+    Hook *hook = hook_of( obj );
+
+    if ( hook->owner_list != this )
+        throw illegal_argument();
+
+    unlink_hook( hook );
+}
+
+// Unlink every object
+template <typename Type, typename Tag>
+void Intrusive_sentinel_list<Type, Tag>::clear() {
+    Hook *hook = list_head.next_hook;
+
+    while ( hook != &list_tail ) {
+        Hook *next = hook->next_hook;
+        hook->previous_hook = nullptr;
+        hook->next_hook = nullptr;
+        hook->owner_list = nullptr;
+        hook = next;
+    }
+
+    list_head.next_hook = &list_tail;
+    list_tail.previous_hook = &list_head;
+    list_size = 0;
+}
+
+/////////////////////////////////////////////////////////////////////////
+//                      Private member functions                       //
+/////////////////////////////////////////////////////////////////////////
+
+template <typename Type, typename Tag>
+typename Intrusive_sentinel_list<Type, Tag>::Hook *Intrusive_sentinel_list<Type, Tag>::hook_of( Type &obj ) {
+	return static_cast<Hook *>( &obj );
+}
+
+// Return the object a hook is part of; the hook must not be a sentinel
+template <typename Type, typename Tag>
+Type &Intrusive_sentinel_list<Type, Tag>::object_of( Hook *hook ) {
+	return *static_cast<Type *>( hook );
+}
+
+// Link an object just before the given hook
+template <typename Type, typename Tag>
+void Intrusive_sentinel_list<Type, Tag>::link_before( Hook *next, Type &obj ) {
+    Hook *hook = hook_of( obj );
+
+    if ( hook->is_linked() )
+        throw illegal_argument();
+
+    hook->previous_hook = next->previous_hook;
+    hook->next_hook = next;
+    hook->owner_list = this;
+    next->previous_hook->next_hook = hook;
+    next->previous_hook = hook;
+    ++list_size;
+}
+
+// Unlink a hook from its neighbours and clear its links
+template <typename Type, typename Tag>
+void Intrusive_sentinel_list<Type, Tag>::unlink_hook( Hook *hook ) {
+    hook->previous_hook->next_hook = hook->next_hook;
+    hook->next_hook->previous_hook = hook->previous_hook;
+    hook->previous_hook = nullptr;
+    hook->next_hook = nullptr;
+    hook->owner_list = nullptr;
+    --list_size;
+}
+
+// Record this list as the owner of every object in it, after a swap()
+template <typename Type, typename Tag>
+void Intrusive_sentinel_list<Type, Tag>::adopt_all() {
+    for ( Hook *hook = list_head.next_hook; hook != &list_tail; hook = hook->next_hook ) {
+        hook->owner_list = this;
+    }
+}
+
+/////////////////////////////////////////////////////////////////////////
+//                               Friends                               //
+/////////////////////////////////////////////////////////////////////////
+
+template <typename T, typename G>
+std::ostream &operator<<( std::ostream &out, Intrusive_sentinel_list<T, G> const &list ) {
+	out << "head->S";
+
+	for ( typename Intrusive_sentinel_list<T, G>::iterator it = list.begin(); it != list.end(); ++it ) {
+		out << "->" << *it;
+	}
+
+	out << "->S";
+
+	return out;
+}
+
+#endif
@@ -0,0 +1,202 @@
+#ifndef NODE_POOL_H
+#define NODE_POOL_H
+
+#include <algorithm>
+#include <new>
+#include <type_traits>
+#include <utility>
+
+// Allocators for the nodes of a linked list
+//
+// An allocator hands out uninitialized storage for one Node at a time; the list constructs
+// and destroys the nodes itself
+//     Node *allocate()           storage for one node
+//     void deallocate( Node * )  return storage from allocate()
+//     void reserve( int )        prepare for n more allocate() calls, as one request if possible
+//     void swap( Allocator & )   exchange all storage with another allocator of the same type
+// Each list owns its allocator, and swapping two lists swaps their allocators
+
+// A slab pool: nodes are carved out of chunks holding many nodes each, freed nodes are
+// kept on a free list for reuse, and the chunks are only released when the pool is destroyed
+// Chunks start at 16 nodes and double up to 4096, so a long list is spread over few chunks
+template <typename Node>
+class Node_pool {
+	public:
+		Node_pool();
+		~Node_pool();
+
+		int available() const;
+
+		Node *allocate();
+		void deallocate( Node * );
+		void reserve( int );
+		void swap( Node_pool & );
+
+	private:
+		// A free slot holds the next free slot; the first slot of a chunk holds the next chunk
+		union Slot {
+			Slot *next;
+			typename std::aligned_storage<sizeof( Node ), alignof( Node )>::type storage;
+		};
+
+		static const int FIRST_CHUNK = 16;
+		static const int LARGEST_CHUNK = 4096;
+
+		Slot *chunks;
+		Slot *free_list;
+		int free_count;
+		Slot *unused;
+		Slot *unused_end;
+		int next_chunk_size;
+
+		void add_chunk( int );
+
+		// The nodes in the chunks belong to a list, so the pool is never copied
+		Node_pool( Node_pool const & );
+		Node_pool &operator=( Node_pool const & );
+};
+
+// One heap allocation per node, as with plain new and delete
+template <typename Node>
+class Heap_allocator {
+	public:
+		Node *allocate();
+		void deallocate( Node * );
+		void reserve( int );
+		void swap( Heap_allocator & );
+};
+
+/////////////////////////////////////////////////////////////////////////
+//                   Constructors and Destructors                      //
+/////////////////////////////////////////////////////////////////////////
+
+// Constructor
+// No chunk is allocated until the first node is
+template <typename Node>
+Node_pool<Node>::Node_pool():
+chunks( nullptr ),
+free_list( nullptr ),
+free_count( 0 ),
+unused( nullptr ),
+unused_end( nullptr ),
+next_chunk_size( FIRST_CHUNK ) {
+	// empty constructor
+}
+
+// Destructor
+// Releases every chunk; the nodes in them must already have been destroyed
+template <typename Node>
+Node_pool<Node>::~Node_pool() {
+    while ( chunks != nullptr ) {
+        Slot *chunk = chunks;
+        chunks = chunk->next;
+        ::operator delete( chunk );
+    }
+}
+
+/////////////////////////////////////////////////////////////////////////
+//                     Public Member Functions                         //
+/////////////////////////////////////////////////////////////////////////
+
+// Return the number of nodes that can be allocated without allocating a chunk
+template <typename Node>
+int Node_pool<Node>::available() const {
+    return free_count + static_cast<int>( unused_end - unused );
+}
+
+// Return storage for one node: a freed slot if there is one, otherwise the next unused
+// slot of the newest chunk, allocating a chunk if that one is used up
+template <typename Node>
+Node *Node_pool<Node>::allocate() {
+    Slot *slot;
+
+    if ( free_list != nullptr ) {
+        slot = free_list;
+        free_list = slot->next;
+        --free_count;
+    } else {
+        if ( unused == unused_end )
+            add_chunk( next_chunk_size );
+
+        slot = unused;
+        ++unused;
+    }
+
+    return reinterpret_cast<Node *>( &slot->storage );
+}
+
+// Put a node's storage on the free list
+template <typename Node>
+void Node_pool<Node>::deallocate( Node *node ) {
+    Slot *slot = reinterpret_cast<Slot *>( node );
+
+    slot->next = free_list;
+    free_list = slot;
+    ++free_count;
+}
+
+// Make sure the next n allocations need no further chunk, adding at most one chunk
+template <typename Node>
+void Node_pool<Node>::reserve( int n ) {
+    if ( n > available() )
+        add_chunk( std::max( n - available(), next_chunk_size ) );
+}
+
+template <typename Node>
+void Node_pool<Node>::swap( Node_pool &pool ) {
+    std::swap( chunks, pool.chunks );
+    std::swap( free_list, pool.free_list );
+    std::swap( free_count, pool.free_count );
+    std::swap( unused, pool.unused );
+    std::swap( unused_end, pool.unused_end );
+    std::swap( next_chunk_size, pool.next_chunk_size );
+}
+
+template <typename Node>
+Node *Heap_allocator<Node>::allocate() {
+    return static_cast<Node *>( ::operator new( sizeof( Node ) ) );
+}
+
+template <typename Node>
+void Heap_allocator<Node>::deallocate( Node *node ) {
+    ::operator delete( node );
+}
+
+// Nodes are allocated one at a time, so there is nothing to prepare
+template <typename Node>
+void Heap_allocator<Node>::reserve( int ) {
+	// nothing to do
+}
+
+// The heap is shared, so there is nothing to exchange
+template <typename Node>
+void Heap_allocator<Node>::swap( Heap_allocator & ) {
+	// nothing to do
+}
+
+/////////////////////////////////////////////////////////////////////////
+//                      Private member functions                       //
+/////////////////////////////////////////////////////////////////////////
+
+// Allocate a chunk of n slots and make it the one unused slots are taken from
+// The slots left unused in the previous chunk go on the free list first
+template <typename Node>
+void Node_pool<Node>::add_chunk( int n ) {
+    for ( ; unused != unused_end; ++unused ) {
+        unused->next = free_list;
+        free_list = unused;
+        ++free_count;
+    }
+
+    Slot *chunk = static_cast<Slot *>( ::operator new( (n + 1) * sizeof( Slot ) ) );
+    chunk->next = chunks;
+    chunks = chunk;
+
+    unused = chunk + 1;
+    unused_end = chunk + 1 + n;
+
+    if ( next_chunk_size < LARGEST_CHUNK )
+        next_chunk_size *= 2;
+}
+
+#endif
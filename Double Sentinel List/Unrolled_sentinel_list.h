@@ -0,0 +1,524 @@
+#ifndef UNROLLED_SENTINEL_LIST_H
+#define UNROLLED_SENTINEL_LIST_H
+
+#include <iostream>
+#include <new>
+#include <type_traits>
+#include <utility>
+#include "Exception.h"
+#include "Node_pool.h"
+
+// An unrolled variant of Double_sentinel_list: each node holds a small array of up to
+// Node_capacity elements rather than a single one, between the same head and tail sentinels
+//
+// A scan such as find() or count() then walks arrays, and follows one pointer per
+// Node_capacity elements rather than one per element; the two pointers of a node are also
+// shared by all of its elements
+// The elements of a node occupy a contiguous run of its array, which can start anywhere,
+// so pushing and popping at either end never shifts elements: push_front() fills the
+// first node towards its start and push_back() fills the last node towards its end,
+// each starting a new node when that end is full
+// erase() compacts each node it removes elements from, frees nodes that become empty,
+// and merges a node into its predecessor when both fit in one node and either is less
+// than half full, so the nodes stay dense
+//
+// By default there are 128 bytes of elements per node, and at least 4 elements
+template <typename Type,
+          int Node_capacity = (sizeof( Type ) * 4 < 128) ? static_cast<int>( 128 / sizeof( Type ) ) : 4,
+          template <typename> class Allocator = Node_pool>
+class Unrolled_sentinel_list {
+	static_assert( Node_capacity >= 2, "An unrolled node must hold at least two elements" );
+
+	public:
+		class Unrolled_node {
+			public:
+				Unrolled_node( Unrolled_node * = nullptr, Unrolled_node * = nullptr );
+
+				int size() const;
+				Type const &value( int ) const;
+				Unrolled_node *previous() const;
+				Unrolled_node *next() const;
+
+				// The elements are slots[first], ..., slots[first + node_size - 1]
+				typename std::aligned_storage<sizeof( Type ), alignof( Type )>::type slots[Node_capacity];
+				int first;
+				int node_size;
+				Unrolled_node *previous_node;
+				Unrolled_node *next_node;
+
+				Type &slot( int );
+		};
+
+		Unrolled_sentinel_list();
+		Unrolled_sentinel_list( Unrolled_sentinel_list const & );
+		Unrolled_sentinel_list( Unrolled_sentinel_list && );
+		~Unrolled_sentinel_list();
+
+		// Accessors
+
+		int size() const;
+		bool empty() const;
+
+		Type front() const;
+		Type back() const;
+
+		Unrolled_node *begin() const;
+		Unrolled_node *end() const;
+		Unrolled_node *rbegin() const;
+		Unrolled_node *rend() const;
+
+		Unrolled_node *find( Type const & ) const;
+		int count( Type const & ) const;
+
+		// Mutators
+
+		void swap( Unrolled_sentinel_list & );
+		Unrolled_sentinel_list &operator=( Unrolled_sentinel_list const & );
+		Unrolled_sentinel_list &operator=( Unrolled_sentinel_list && );
+
+		void push_front( Type const & );
+		void push_back( Type const & );
+
+		void pop_front();
+		void pop_back();
+
+		int erase( Type const & );
+
+	private:
+		// Declared first, so that the sentinels can be allocated from it
+		Allocator<Unrolled_node> nodes;
+		Unrolled_node *list_head;
+		Unrolled_node *list_tail;
+		int list_size;
+
+		Unrolled_node *create_node( Unrolled_node *, Unrolled_node * );
+		void unlink_node( Unrolled_node * );
+		void merge_into_previous( Unrolled_node * );
+		void destroy_all();
+
+	// Friends
+
+	template <typename T, int B, template <typename> class A>
+	friend std::ostream &operator<<( std::ostream &, Unrolled_sentinel_list<T, B, A> const & );
+};
+
+/////////////////////////////////////////////////////////////////////////
+//                   Constructors and Destructors                      //
+/////////////////////////////////////////////////////////////////////////
+
+// Constructor
+// The two sentinels hold no elements and point to each other
+template <typename Type, int Node_capacity, template <typename> class Allocator>
+Unrolled_sentinel_list<Type, Node_capacity, Allocator>::Unrolled_sentinel_list():
+nodes(),
+list_head( create_node( nullptr, nullptr ) ),
+list_tail( create_node( list_head, nullptr ) ),
+list_size( 0 ) {
+	list_head->next_node = list_tail;
+}
+
+// Copy Constructor
+// The copy packs its nodes full, and reserves them all from the allocator first
+template <typename Type, int Node_capacity, template <typename> class Allocator>
+Unrolled_sentinel_list<Type, Node_capacity, Allocator>::Unrolled_sentinel_list( Unrolled_sentinel_list const &list ):
+nodes(),
+list_head( create_node( nullptr, nullptr ) ),
+list_tail( create_node( list_head, nullptr ) ),
+list_size( 0 ) {
+    list_head->next_node = list_tail;
+    nodes.reserve( (list.size() + Node_capacity - 1) / Node_capacity );
+
+    for ( Unrolled_node *ptr = list.begin(); ptr != list.end(); ptr = ptr->next() ) {
+        for ( int i = 0; i < ptr->size(); ++i ) {
+            push_back( ptr->value( i ) );
+        }
+    }
+}
+
+// Move Constructor
+template <typename Type, int Node_capacity, template <typename> class Allocator>
+Unrolled_sentinel_list<Type, Node_capacity, Allocator>::Unrolled_sentinel_list( Unrolled_sentinel_list &&list ):
+nodes(),
+list_head( create_node( nullptr, nullptr ) ),
+list_tail( create_node( list_head, nullptr ) ),
+list_size( 0 ) {
+	list_head->next_node = list_tail;
+	swap( list );
+}
+
+// Destructor
+template <typename Type, int Node_capacity, template <typename> class Allocator>
+Unrolled_sentinel_list<Type, Node_capacity, Allocator>::~Unrolled_sentinel_list() {
+    destroy_all();
+    nodes.deallocate( list_head );
+    nodes.deallocate( list_tail );
+}
+
+/////////////////////////////////////////////////////////////////////////
+//                      Public member functions                        //
+/////////////////////////////////////////////////////////////////////////
+
+template <typename Type, int Node_capacity, template <typename> class Allocator>
+int Unrolled_sentinel_list<Type, Node_capacity, Allocator>::size() const {
+	return list_size;
+}
+
+template <typename Type, int Node_capacity, template <typename> class Allocator>
+bool Unrolled_sentinel_list<Type, Node_capacity, Allocator>::empty() const {
+	return list_size == 0;
+}
+
+template <typename Type, int Node_capacity, template <typename> class Allocator>
+Type Unrolled_sentinel_list<Type, Node_capacity, Allocator>::front() const {
+	if ( empty() )
+		throw underflow();
+
+	return begin()->value( 0 );
+}
+
+template <typename Type, int Node_capacity, template <typename> class Allocator>
+Type Unrolled_sentinel_list<Type, Node_capacity, Allocator>::back() const {
+	if ( empty() )
+		throw underflow();
+
+	return rbegin()->value( rbegin()->size() - 1 );
+}
+
+// Return the first node holding elements, or end() if the list is empty
+template <typename Type, int Node_capacity, template <typename> class Allocator>
+typename Unrolled_sentinel_list<Type, Node_capacity, Allocator>::Unrolled_node *
+Unrolled_sentinel_list<Type, Node_capacity, Allocator>::begin() const {
+	return list_head->next();
+}
+
+// Return the tail sentinel
+template <typename Type, int Node_capacity, template <typename> class Allocator>
+typename Unrolled_sentinel_list<Type, Node_capacity, Allocator>::Unrolled_node *
+Unrolled_sentinel_list<Type, Node_capacity, Allocator>::end() const {
+	return list_tail;
+}
+
+// Return the last node holding elements, or rend() if the list is empty
+template <typename Type, int Node_capacity, template <typename> class Allocator>
+typename Unrolled_sentinel_list<Type, Node_capacity, Allocator>::Unrolled_node *
+Unrolled_sentinel_list<Type, Node_capacity, Allocator>::rbegin() const {
+	return list_tail->previous();
+}
+
+// Return the head sentinel
+template <typename Type, int Node_capacity, template <typename> class Allocator>
+typename Unrolled_sentinel_list<Type, Node_capacity, Allocator>::Unrolled_node *
+Unrolled_sentinel_list<Type, Node_capacity, Allocator>::rend() const {
+	return list_head;
+}
+
+// Return the node holding the first instance of the argument, or end() if there is none
+template <typename Type, int Node_capacity, template <typename> class Allocator>
+typename Unrolled_sentinel_list<Type, Node_capacity, Allocator>::Unrolled_node *
+Unrolled_sentinel_list<Type, Node_capacity, Allocator>::find( Type const &obj ) const {
+    for ( Unrolled_node *ptr = begin(); ptr != end(); ptr = ptr->next() ) {
+        for ( int i = 0; i < ptr->size(); ++i ) {
+            if ( ptr->value( i ) == obj )
+                return ptr;
+        }
+    }
+
+    return end();
+}
+
+// Return the number of instances of the argument
+template <typename Type, int Node_capacity, template <typename> class Allocator>
+int Unrolled_sentinel_list<Type, Node_capacity, Allocator>::count( Type const &obj ) const {
+    int n = 0;
+
+    for ( Unrolled_node *ptr = begin(); ptr != end(); ptr = ptr->next() ) {
+        for ( int i = 0; i < ptr->size(); ++i ) {
+            if ( ptr->value( i ) == obj )
+                ++n;
+        }
+    }
+
+    return n;
+}
+
+// Swap the sentinels, sizes and allocators, since each list's nodes live in its own allocator
+template <typename Type, int Node_capacity, template <typename> class Allocator>
+void Unrolled_sentinel_list<Type, Node_capacity, Allocator>::swap( Unrolled_sentinel_list &list ) {
+	std::swap( list_head, list.list_head );
+	std::swap( list_tail, list.list_tail );
+	std::swap( list_size, list.list_size );
+	nodes.swap( list.nodes );
+}
+
+template <typename Type, int Node_capacity, template <typename> class Allocator>
+Unrolled_sentinel_list<Type, Node_capacity, Allocator> &
+Unrolled_sentinel_list<Type, Node_capacity, Allocator>::operator=( Unrolled_sentinel_list const &rhs ) {
+	Unrolled_sentinel_list copy( rhs );
+	swap( copy );
+
+	return *this;
+}
+
+template <typename Type, int Node_capacity, template <typename> class Allocator>
+Unrolled_sentinel_list<Type, Node_capacity, Allocator> &
+Unrolled_sentinel_list<Type, Node_capacity, Allocator>::operator=( Unrolled_sentinel_list &&rhs ) {
+	swap( rhs );
+
+	return *this;
+}
+
+// Insert an object at the front, in the free space before the first node's elements,
+// or in a new node, filled from its end, if there is none
+template <typename Type, int Node_capacity, template <typename> class Allocator>
+void Unrolled_sentinel_list<Type, Node_capacity, Allocator>::push_front( Type const &obj ) {
+    Unrolled_node *node = begin();
+
+    if ( node == end() || node->first == 0 ) {
+        node = create_node( list_head, begin() );
+        node->first = Node_capacity;
+        list_head->next_node = node;
+        node->next_node->previous_node = node;
+    }
+
+    new ( &node->slot( node->first - 1 ) ) Type( obj );
+    --node->first;
+    ++node->node_size;
+    ++list_size;
+}
+
+// Insert an object at the back, in the free space after the last node's elements,
+// or in a new node, filled from its start, if there is none
+template <typename Type, int Node_capacity, template <typename> class Allocator>
+void Unrolled_sentinel_list<Type, Node_capacity, Allocator>::push_back( Type const &obj ) {
+    Unrolled_node *node = rbegin();
+
+    if ( node == rend() || node->first + node->node_size == Node_capacity ) {
+        node = create_node( rbegin(), list_tail );
+        list_tail->previous_node = node;
+        node->previous_node->next_node = node;
+    }
+
+    new ( &node->slot( node->first + node->node_size ) ) Type( obj );
+    ++node->node_size;
+    ++list_size;
+}
+
+// Remove the object at the front, freeing its node if it was the node's last element
+template <typename Type, int Node_capacity, template <typename> class Allocator>
+void Unrolled_sentinel_list<Type, Node_capacity, Allocator>::pop_front() {
+	if ( empty() )
+		throw underflow();
+
+    Unrolled_node *node = begin();
+
+    node->slot( node->first ).~Type();
+    ++node->first;
+    --node->node_size;
+    --list_size;
+
+    if ( node->node_size == 0 )
+        unlink_node( node );
+}
+
+// Remove the object at the back, freeing its node if it was the node's last element
+template <typename Type, int Node_capacity, template <typename> class Allocator>
+void Unrolled_sentinel_list<Type, Node_capacity, Allocator>::pop_back() {
+	if ( empty() )
+		throw underflow();
+
+    Unrolled_node *node = rbegin();
+
+    node->slot( node->first + node->node_size - 1 ).~Type();
+    --node->node_size;
+    --list_size;
+
+    if ( node->node_size == 0 )
+        unlink_node( node );
+}
+
+// Remove every instance of the argument and return how many there were
+// Each node is compacted in place; a node left empty is freed, and a node left sparse
+// is merged into its predecessor, which has already been compacted
+template <typename Type, int Node_capacity, template <typename> class Allocator>
+int Unrolled_sentinel_list<Type, Node_capacity, Allocator>::erase( Type const &obj ) {
+    int erased = 0;
+    Unrolled_node *node = begin();
+
+    while ( node != end() ) {
+        Unrolled_node *next = node->next();
+        int kept = node->first;
+
+        for ( int i = node->first; i < node->first + node->node_size; ++i ) {
+            Type &element = node->slot( i );
+
+            if ( element == obj ) {
+                element.~Type();
+                ++erased;
+            } else {
+                if ( kept != i ) {
+                    new ( &node->slot( kept ) ) Type( std::move( element ) );
+                    element.~Type();
+                }
+
+                ++kept;
+            }
+        }
+
+        list_size -= node->node_size - (kept - node->first);
+        node->node_size = kept - node->first;
+
+        if ( node->node_size == 0 ) {
+            unlink_node( node );
+        } else {
+            merge_into_previous( node );
+        }
+
+        node = next;
+    }
+
+    return erased;
+}
+
+/////////////////////////////////////////////////////////////////////////
+//                      Unrolled_node functions                        //
+/////////////////////////////////////////////////////////////////////////
+
+template <typename Type, int Node_capacity, template <typename> class Allocator>
+Unrolled_sentinel_list<Type, Node_capacity, Allocator>::Unrolled_node::Unrolled_node( Unrolled_node *pn, Unrolled_node *nn ):
+first( 0 ),
+node_size( 0 ),
+previous_node( pn ),
+next_node( nn ) {
+	// empty constructor
+}
+
+// Return the number of elements in the node
+template <typename Type, int Node_capacity, template <typename> class Allocator>
+int Unrolled_sentinel_list<Type, Node_capacity, Allocator>::Unrolled_node::size() const {
+	return node_size;
+}
+
+// Return the i-th element of the node, for 0 <= i < size()
+template <typename Type, int Node_capacity, template <typename> class Allocator>
+Type const &Unrolled_sentinel_list<Type, Node_capacity, Allocator>::Unrolled_node::value( int i ) const {
+	return *reinterpret_cast<Type const *>( &slots[first + i] );
+}
+
+template <typename Type, int Node_capacity, template <typename> class Allocator>
+typename Unrolled_sentinel_list<Type, Node_capacity, Allocator>::Unrolled_node *
+Unrolled_sentinel_list<Type, Node_capacity, Allocator>::Unrolled_node::previous() const {
+	return previous_node;
+}
+
+template <typename Type, int Node_capacity, template <typename> class Allocator>
+typename Unrolled_sentinel_list<Type, Node_capacity, Allocator>::Unrolled_node *
+Unrolled_sentinel_list<Type, Node_capacity, Allocator>::Unrolled_node::next() const {
+	return next_node;
+}
+
+// Return slot i of the array, which need not hold an element
+template <typename Type, int Node_capacity, template <typename> class Allocator>
+Type &Unrolled_sentinel_list<Type, Node_capacity, Allocator>::Unrolled_node::slot( int i ) {
+	return *reinterpret_cast<Type *>( &slots[i] );
+}
+
+/////////////////////////////////////////////////////////////////////////
+//                      Private member functions                       //
+/////////////////////////////////////////////////////////////////////////
+
+// Construct an empty node, which the caller links in
+template <typename Type, int Node_capacity, template <typename> class Allocator>
+typename Unrolled_sentinel_list<Type, Node_capacity, Allocator>::Unrolled_node *
+Unrolled_sentinel_list<Type, Node_capacity, Allocator>::create_node( Unrolled_node *pn, Unrolled_node *nn ) {
+    return new ( nodes.allocate() ) Unrolled_node( pn, nn );
+}
+
+// Unlink a node, whose elements must already have been destroyed, and free it
+template <typename Type, int Node_capacity, template <typename> class Allocator>
+void Unrolled_sentinel_list<Type, Node_capacity, Allocator>::unlink_node( Unrolled_node *node ) {
+    node->previous_node->next_node = node->next_node;
+    node->next_node->previous_node = node->previous_node;
+    nodes.deallocate( node );
+}
+
+// Move the elements of a node to the end of its predecessor and free it, if they fit
+// there and either node is less than half full
+// The predecessor's elements are first moved to the start of its array to make room
+template <typename Type, int Node_capacity, template <typename> class Allocator>
+void Unrolled_sentinel_list<Type, Node_capacity, Allocator>::merge_into_previous( Unrolled_node *node ) {
+    Unrolled_node *previous = node->previous();
+
+    if ( previous == rend() || previous->node_size + node->node_size > Node_capacity )
+        return;
+
+    if ( 2*previous->node_size >= Node_capacity && 2*node->node_size >= Node_capacity )
+        return;
+
+    if ( previous->first + previous->node_size + node->node_size > Node_capacity ) {
+        for ( int i = 0; i < previous->node_size; ++i ) {
+            Type &element = previous->slot( previous->first + i );
+            new ( &previous->slot( i ) ) Type( std::move( element ) );
+            element.~Type();
+        }
+
+        previous->first = 0;
+    }
+
+    for ( int i = 0; i < node->node_size; ++i ) {
+        Type &element = node->slot( node->first + i );
+        new ( &previous->slot( previous->first + previous->node_size ) ) Type( std::move( element ) );
+        element.~Type();
+        ++previous->node_size;
+    }
+
+    unlink_node( node );
+}
+
+// Destroy every element and free every node between the sentinels
+template <typename Type, int Node_capacity, template <typename> class Allocator>
+void Unrolled_sentinel_list<Type, Node_capacity, Allocator>::destroy_all() {
+    Unrolled_node *node = begin();
+
+    while ( node != end() ) {
+        Unrolled_node *next = node->next();
+
+        if ( !std::is_trivially_destructible<Type>::value ) {
+            for ( int i = node->first; i < node->first + node->node_size; ++i ) {
+                node->slot( i ).~Type();
+            }
+        }
+
+        nodes.deallocate( node );
+        node = next;
+    }
+
+    list_head->next_node = list_tail;
+    list_tail->previous_node = list_head;
+    list_size = 0;
+}
+
+/////////////////////////////////////////////////////////////////////////
+//                               Friends                               //
+/////////////////////////////////////////////////////////////////////////
+
+// Prints the nodes between the sentinels, with the elements of each in brackets
+template <typename T, int B, template <typename> class A>
+std::ostream &operator<<( std::ostream &out, Unrolled_sentinel_list<T, B, A> const &list ) {
+	out << "head->S";
+
+	for ( typename Unrolled_sentinel_list<T, B, A>::Unrolled_node *ptr = list.begin(); ptr != list.end(); ptr = ptr->next() ) {
+		out << "->[";
+
+		for ( int i = 0; i < ptr->size(); ++i ) {
+			out << (i == 0 ? "" : " ") << ptr->value( i );
+		}
+
+		out << "]";
+	}
+
+	out << "->S";
+
+	return out;
+}
+
+#endif
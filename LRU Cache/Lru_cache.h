@@ -0,0 +1,235 @@
+#ifndef LRU_CACHE_H
+#define LRU_CACHE_H
+
+#include "Exception.h"
+#include "Double_sentinel_list.h"
+#include "Quadratic_hash_map.h"
+
+// A cache of at most a fixed number of key/value pairs that evicts the least recently used
+// pair to make room for a new one
+//
+// The pairs are kept in a Double_sentinel_list ordered from the most to the least recently
+// used, and a Quadratic_hash_map indexes the list nodes by key; the nodes never move, so the
+// index stays valid however the list is relinked
+// get(), put(), erase() and eviction each take one or two probes of the index and O(1)
+// relinking of the list, however many pairs are cached
+//
+// The list keeps its sentinels as nodes holding a default pair, so Key and Value must be
+// default constructible
+template <typename Key, typename Value, typename Hash = Mixing_hash<Key> >
+class Lru_cache {
+	private:
+		class Entry {
+			public:
+				Key   entry_key;
+				Value entry_value;
+		};
+
+		typedef Double_sentinel_list<Entry> List;
+		typedef typename List::Double_node Node;
+
+		int cache_capacity;
+		List recency;
+		Quadratic_hash_map<Key, Node *, Hash> index;
+
+		static int index_power( int );
+
+		// The index refers to the nodes of this cache's own list, so the cache is never copied
+		Lru_cache( Lru_cache const & );
+		Lru_cache &operator=( Lru_cache const & );
+
+	public:
+		Lru_cache( int, Hash const & = Hash() );
+
+		// Accessors
+
+		int size() const;
+		int capacity() const;
+		bool empty() const;
+		bool member( Key const & ) const;
+		Value const *peek( Key const & ) const;
+		Key const &least_recent() const;
+
+		// Mutators
+
+		Value *get( Key const & );
+		bool put( Key const &, Value const & );
+		bool erase( Key const & );
+		void evict();
+		void clear();
+
+	// Friends
+
+	template <typename K, typename V, typename H>
+	friend std::ostream &operator<<( std::ostream &, Lru_cache<K, V, H> const & );
+};
+
+/////////////////////////////////////////////////////////////////////////
+//                   Constructors and Destructors                      //
+/////////////////////////////////////////////////////////////////////////
+
+// Constructor
+// The index is created large enough that filling the cache never grows it
+template <typename Key, typename Value, typename Hash>
+Lru_cache<Key, Value, Hash>::Lru_cache( int n, Hash const &hf ):
+cache_capacity( n ),
+recency(),
+index( index_power( n ), 0.75, hf ) {
+    if ( n <= 0 )
+        throw illegal_argument();
+}
+
+/////////////////////////////////////////////////////////////////////////
+//                     Public Member Functions                         //
+/////////////////////////////////////////////////////////////////////////
+
+//ACCESSORS
+
+template <typename Key, typename Value, typename Hash>
+int Lru_cache<Key, Value, Hash>::size() const {
+	return recency.size();
+}
+
+// Return the largest number of pairs the cache holds
+template <typename Key, typename Value, typename Hash>
+int Lru_cache<Key, Value, Hash>::capacity() const {
+	return cache_capacity;
+}
+
+template <typename Key, typename Value, typename Hash>
+bool Lru_cache<Key, Value, Hash>::empty() const {
+	return recency.empty();
+}
+
+// Return true if the key is cached, without counting this as a use
+template <typename Key, typename Value, typename Hash>
+bool Lru_cache<Key, Value, Hash>::member( Key const &key ) const {
+    return index.member( key );
+}
+
+// Return a pointer to the value of the key, or nullptr if it is not cached,
+// without counting this as a use
+template <typename Key, typename Value, typename Hash>
+Value const *Lru_cache<Key, Value, Hash>::peek( Key const &key ) const {
+    Node * const *node = index.find( key );
+
+    return (node == nullptr) ? nullptr : &(*node)->node_value.entry_value;
+}
+
+// Return the key that the next eviction removes
+template <typename Key, typename Value, typename Hash>
+Key const &Lru_cache<Key, Value, Hash>::least_recent() const {
+    if ( empty() )
+        throw underflow();
+
+    return recency.rbegin()->node_value.entry_key;
+}
+
+//MUTATORS
+
+// Return a pointer to the value of the key, or nullptr if it is not cached
+// A hit makes the pair the most recently used; the pointer stays valid until the pair
+// is evicted or erased
+template <typename Key, typename Value, typename Hash>
+Value *Lru_cache<Key, Value, Hash>::get( Key const &key ) {
+    Node **node = index.find( key );
+
+    if ( node == nullptr )
+        return nullptr;
+
+    recency.move_to_front( *node );
+
+    return &(*node)->node_value.entry_value;
+}
+
+// Cache the value for the key as the most recently used pair, evicting the least recently
+// used pair first if the key is new and the cache is full
+// Returns true if the key was inserted, false if its value was replaced
+template <typename Key, typename Value, typename Hash>
+bool Lru_cache<Key, Value, Hash>::put( Key const &key, Value const &value ) {
+    Node **node = index.find( key );
+
+    if ( node != nullptr ) {
+        (*node)->node_value.entry_value = value;
+        recency.move_to_front( *node );
+
+        return false;
+    }
+
+    // Evict before inserting, since an erase from the index may migrate its entries
+    if ( recency.size() == cache_capacity )
+        evict();
+
+    Entry entry = { key, value };
+    recency.push_front( entry );
+    index.try_emplace( key, recency.begin() );
+
+    return true;
+}
+
+// Removes the key and its value and returns true on success, false otherwise
+template <typename Key, typename Value, typename Hash>
+bool Lru_cache<Key, Value, Hash>::erase( Key const &key ) {
+    Node **node = index.find( key );
+
+    if ( node == nullptr )
+        return false;
+
+    Node *erased = *node;
+    index.erase( key );
+    recency.erase_node( erased );
+
+    return true;
+}
+
+// Remove the least recently used pair
+template <typename Key, typename Value, typename Hash>
+void Lru_cache<Key, Value, Hash>::evict() {
+    if ( empty() )
+        throw underflow();
+
+    index.erase( recency.rbegin()->node_value.entry_key );
+    recency.pop_back();
+}
+
+template <typename Key, typename Value, typename Hash>
+void Lru_cache<Key, Value, Hash>::clear() {
+    index.clear();
+
+    while ( !recency.empty() ) {
+        recency.pop_back();
+    }
+}
+
+/////////////////////////////////////////////////////////////////////////
+//                      Private member functions                       //
+/////////////////////////////////////////////////////////////////////////
+
+// Return the power of 2 for an index of n keys that stays at most half full,
+// so that ERASED bins left by evictions only occasionally force a rehash
+template <typename Key, typename Value, typename Hash>
+int Lru_cache<Key, Value, Hash>::index_power( int n ) {
+    int m = 5;
+
+    while ( m < 30 && (1 << m) < 2 * n ) {
+        ++m;
+    }
+
+    return m;
+}
+
+/////////////////////////////////////////////////////////////////////////
+//                               Friends                               //
+/////////////////////////////////////////////////////////////////////////
+
+// Print the pairs from the most to the least recently used
+template <typename K, typename V, typename H>
+std::ostream &operator<<( std::ostream &out, Lru_cache<K, V, H> const &cache ) {
+	for ( typename Lru_cache<K, V, H>::Node *ptr = cache.recency.begin(); ptr != cache.recency.end(); ptr = ptr->next() ) {
+		out << ptr->node_value.entry_key << ':' << ptr->node_value.entry_value << ' ';
+	}
+
+	return out;
+}
+
+#endif
@@ -0,0 +1,176 @@
+// Hit-rate and throughput benchmark for Lru_cache and Sharded_lru_cache
+//
+// Keys are drawn from a Zipf distribution over the key range, so a few keys are requested
+// far more often than the rest, as in most real caches
+// Each request is a get(), followed by a put() of the key on a miss
+//
+// First, one thread runs the requests against caches with capacities of 1%, 5%, 10% and 25% of
+// the key range, reporting the hit rate and the throughput
+// Then the sharded cache is compared against one Lru_cache behind one global mutex,
+// for 1, 2, 4, ... threads up to the number of hardware threads
+//
+// Build and run with, for example:
+//     g++ -std=c++17 -O2 -pthread -I"../Double Sentinel List" -I"../Quadratic Hash Table" Lru_cache_benchmark.cpp -o lru_benchmark
+//     ./lru_benchmark [requests per thread] [key range] [Zipf exponent] [shard power] [maximum threads]
+
+#include <algorithm>
+#include <chrono>
+#include <cmath>
+#include <cstdlib>
+#include <iostream>
+#include <mutex>
+#include <random>
+#include <thread>
+#include <vector>
+#include "Sharded_lru_cache.h"
+
+// An Lru_cache behind a single mutex, the arrangement the sharded cache replaces
+class Locked_lru_cache {
+	public:
+		Locked_lru_cache( int n ):
+		cache( n ) {
+			// empty constructor
+		}
+
+		bool get( long long key, long long &value ) {
+		    std::lock_guard<std::mutex> lock( cache_mutex );
+		    long long *cached = cache.get( key );
+
+		    if ( cached == nullptr )
+		        return false;
+
+		    value = *cached;
+		    return true;
+		}
+
+		bool put( long long key, long long value ) {
+		    std::lock_guard<std::mutex> lock( cache_mutex );
+		    return cache.put( key, value );
+		}
+
+	private:
+		std::mutex cache_mutex;
+		Lru_cache<long long, long long> cache;
+};
+
+// Draw count keys in [0, key_range) with probability proportional to 1/(rank + 1)^exponent
+// The keys are shuffled ranks, so popular keys are not also adjacent integers
+std::vector<long long> zipf_keys( long count, long long key_range, double exponent, unsigned seed ) {
+    std::vector<double> cumulative( key_range );
+    double total = 0.0;
+
+    for ( long long k = 0; k < key_range; ++k ) {
+        total += 1.0 / std::pow( static_cast<double>( k + 1 ), exponent );
+        cumulative[k] = total;
+    }
+
+    std::vector<long long> key_of_rank( key_range );
+
+    for ( long long k = 0; k < key_range; ++k ) {
+        key_of_rank[k] = k;
+    }
+
+    std::mt19937_64 random( seed );
+    std::shuffle( key_of_rank.begin(), key_of_rank.end(), std::mt19937_64( 42 ) );
+    std::uniform_real_distribution<double> uniform( 0.0, total );
+    std::vector<long long> keys( count );
+
+    for ( long i = 0; i < count; ++i ) {
+        long long rank = std::lower_bound( cumulative.begin(), cumulative.end(), uniform( random ) ) - cumulative.begin();
+        keys[i] = key_of_rank[std::min( rank, key_range - 1 )];
+    }
+
+    return keys;
+}
+
+// Run the requests of each thread against the cache, one thread per key stream
+// Returns the throughput in millions of requests per second, and adds up the hits
+template <typename Cache>
+double run( Cache &cache, std::vector<std::vector<long long> > const &streams, long &hits ) {
+    std::vector<std::thread> workers;
+    std::vector<long> thread_hits( streams.size(), 0 );
+    auto start = std::chrono::steady_clock::now();
+
+    for ( std::size_t t = 0; t < streams.size(); ++t ) {
+        workers.emplace_back( [&cache, &streams, &thread_hits, t]() {
+            long found = 0;
+            long long value;
+
+            for ( long long key : streams[t] ) {
+                if ( cache.get( key, value ) ) {
+                    ++found;
+                } else {
+                    cache.put( key, key );
+                }
+            }
+
+            thread_hits[t] = found;
+        } );
+    }
+
+    for ( std::thread &worker : workers ) {
+        worker.join();
+    }
+
+    std::chrono::duration<double> elapsed = std::chrono::steady_clock::now() - start;
+    long requests = 0;
+    hits = 0;
+
+    for ( std::size_t t = 0; t < streams.size(); ++t ) {
+        requests += static_cast<long>( streams[t].size() );
+        hits += thread_hits[t];
+    }
+
+    return requests / elapsed.count() / 1e6;
+}
+
+int main( int argc, char **argv ) {
+    long requests = (argc > 1) ? std::atol( argv[1] ) : 2000000;
+    long long key_range = (argc > 2) ? std::atoll( argv[2] ) : 1000000;
+    double exponent = (argc > 3) ? std::atof( argv[3] ) : 0.99;
+    int shard_power = (argc > 4) ? std::atoi( argv[4] ) : 6;
+    int max_threads = (argc > 5) ? std::atoi( argv[5] ) : std::max( 1, static_cast<int>( std::thread::hardware_concurrency() ) );
+
+    std::vector<std::vector<long long> > streams;
+
+    for ( int t = 0; t < max_threads; ++t ) {
+        streams.push_back( zipf_keys( requests, key_range, exponent, 12345 + t ) );
+    }
+
+    std::cout << "capacity  hit rate  single thread (Mops/s)" << std::endl;
+
+    double fractions[] = { 0.01, 0.05, 0.10, 0.25 };
+
+    for ( double fraction : fractions ) {
+        int capacity = std::max( 1, static_cast<int>( fraction * key_range ) );
+        Locked_lru_cache cache( capacity );
+        std::vector<std::vector<long long> > one( streams.begin(), streams.begin() + 1 );
+        long hits;
+
+        double rate = run( cache, one, hits );
+
+        std::cout << capacity << "     " << static_cast<double>( hits ) / requests << "    " << rate << std::endl;
+    }
+
+    int capacity = std::max( 1, static_cast<int>( 0.10 * key_range ) );
+
+    std::cout << std::endl << "capacity " << capacity << std::endl;
+    std::cout << "threads  global mutex (Mops/s, hit rate)  sharded (Mops/s, hit rate)" << std::endl;
+
+    for ( int threads = 1; threads <= max_threads; threads *= 2 ) {
+        std::vector<std::vector<long long> > used( streams.begin(), streams.begin() + threads );
+        Locked_lru_cache locked( capacity );
+        Sharded_lru_cache<long long, long long> sharded( capacity, shard_power );
+        long locked_hits;
+        long sharded_hits;
+
+        double locked_rate = run( locked, used, locked_hits );
+        double sharded_rate = run( sharded, used, sharded_hits );
+        double total = static_cast<double>( threads ) * requests;
+
+        std::cout << threads << "        " << locked_rate << ", " << locked_hits / total
+                  << "                " << sharded_rate << ", " << sharded_hits / total << std::endl;
+    }
+
+    return 0;
+}
@@ -0,0 +1,197 @@
+#ifndef SHARDED_LRU_CACHE_H
+#define SHARDED_LRU_CACHE_H
+
+#include <cstdint>
+#include <mutex>
+#include "Lru_cache.h"
+
+// A thread-safe LRU cache that splits the keys across 2^s independent Lru_caches
+// The shard of a key is chosen by the high bits of its hash value, as in
+// Concurrent_hash_table, while each shard's index uses the low bits to choose a bin
+//
+// Every shard has its own mutex, so operations on keys of different shards proceed in
+// parallel; even a lookup relinks the recency list, so a shard lock is never shared
+// Each shard evicts its own least recently used pair, which approximates LRU over the
+// whole cache once the shards hold more than a few pairs each
+//
+// Values are copied out under the lock, since a pointer into a shard could be evicted
+// by another thread as soon as the lock is released
+// size() locks each shard in turn, so under concurrent modification it is only a snapshot
+template <typename Key, typename Value, typename Hash = Mixing_hash<Key> >
+class Sharded_lru_cache {
+	private:
+		// One cache and its lock, padded to a cache line of its own so that shards
+		// used by different threads do not share lines
+		class alignas(64) Shard : public Lru_cache<Key, Value, Hash> {
+			public:
+				Shard( int, Hash const & );
+
+				std::mutex shard_mutex;
+		};
+
+		int shard_power;
+		int shard_count;
+		Shard **shards;
+		Hash hash_function;
+
+		Shard &shard_of( Key const & ) const;
+
+		// The shards are owned by the cache and are not shared between caches
+		Sharded_lru_cache( Sharded_lru_cache const & );
+		Sharded_lru_cache &operator=( Sharded_lru_cache const & );
+
+	public:
+		Sharded_lru_cache( int, int = 4, Hash const & = Hash() );
+		~Sharded_lru_cache();
+
+		int shards_count() const;
+		int size() const;
+		int capacity() const;
+		bool member( Key const & ) const;
+
+		bool get( Key const &, Value & );
+		bool put( Key const &, Value const & );
+		bool erase( Key const & );
+		void clear();
+};
+
+/////////////////////////////////////////////////////////////////////////
+//                   Constructors and Destructors                      //
+/////////////////////////////////////////////////////////////////////////
+
+template <typename Key, typename Value, typename Hash>
+Sharded_lru_cache<Key, Value, Hash>::Shard::Shard( int n, Hash const &hf ):
+Lru_cache<Key, Value, Hash>( n, hf ),
+shard_mutex() {
+	// empty constructor
+}
+
+// Constructor
+// Creates 2^s shards that share a total capacity of at least n pairs
+template <typename Key, typename Value, typename Hash>
+Sharded_lru_cache<Key, Value, Hash>::Sharded_lru_cache( int n, int s, Hash const &hf ):
+shard_power( (s >= 0 && s <= 16) ? s : 4 ),
+shard_count( 1 << shard_power ),
+shards( nullptr ),
+hash_function( hf ) {
+    if ( n <= 0 )
+        throw illegal_argument();
+
+    int per_shard = (n + shard_count - 1) / shard_count;
+    shards = new Shard *[shard_count];
+
+    for ( int i = 0; i < shard_count; ++i ) {
+        shards[i] = new Shard( per_shard, hf );
+    }
+}
+
+// Destructor
+template <typename Key, typename Value, typename Hash>
+Sharded_lru_cache<Key, Value, Hash>::~Sharded_lru_cache() {
+    for ( int i = 0; i < shard_count; ++i ) {
+        delete shards[i];
+    }
+
+    delete [] shards;
+}
+
+/////////////////////////////////////////////////////////////////////////
+//                     Public Member Functions                         //
+/////////////////////////////////////////////////////////////////////////
+
+//ACCESSORS
+
+// Return the number of shards
+template <typename Key, typename Value, typename Hash>
+int Sharded_lru_cache<Key, Value, Hash>::shards_count() const {
+    return shard_count;
+}
+
+// Return the number of pairs cached in all shards
+template <typename Key, typename Value, typename Hash>
+int Sharded_lru_cache<Key, Value, Hash>::size() const {
+    int total = 0;
+
+    for ( int i = 0; i < shard_count; ++i ) {
+        std::lock_guard<std::mutex> lock( shards[i]->shard_mutex );
+        total += shards[i]->size();
+    }
+
+    return total;
+}
+
+// Return the total capacity of the shards
+template <typename Key, typename Value, typename Hash>
+int Sharded_lru_cache<Key, Value, Hash>::capacity() const {
+    return shard_count * shards[0]->capacity();
+}
+
+// Return true if the key is cached, without counting this as a use
+template <typename Key, typename Value, typename Hash>
+bool Sharded_lru_cache<Key, Value, Hash>::member( Key const &key ) const {
+    Shard &shard = shard_of( key );
+    std::lock_guard<std::mutex> lock( shard.shard_mutex );
+
+    return shard.member( key );
+}
+
+//MUTATORS
+
+// Copy the value of the key into the second argument and return true if it is cached,
+// making it the most recently used pair of its shard; return false otherwise
+template <typename Key, typename Value, typename Hash>
+bool Sharded_lru_cache<Key, Value, Hash>::get( Key const &key, Value &value ) {
+    Shard &shard = shard_of( key );
+    std::lock_guard<std::mutex> lock( shard.shard_mutex );
+
+    Value *cached = shard.get( key );
+
+    if ( cached == nullptr )
+        return false;
+
+    value = *cached;
+
+    return true;
+}
+
+// Cache the value for the key, evicting from its shard if necessary
+// Returns true if the key was inserted, false if its value was replaced
+template <typename Key, typename Value, typename Hash>
+bool Sharded_lru_cache<Key, Value, Hash>::put( Key const &key, Value const &value ) {
+    Shard &shard = shard_of( key );
+    std::lock_guard<std::mutex> lock( shard.shard_mutex );
+
+    return shard.put( key, value );
+}
+
+// Removes the key and its value and returns true on success, false otherwise
+template <typename Key, typename Value, typename Hash>
+bool Sharded_lru_cache<Key, Value, Hash>::erase( Key const &key ) {
+    Shard &shard = shard_of( key );
+    std::lock_guard<std::mutex> lock( shard.shard_mutex );
+
+    return shard.erase( key );
+}
+
+// Clear every shard, one at a time
+template <typename Key, typename Value, typename Hash>
+void Sharded_lru_cache<Key, Value, Hash>::clear() {
+    for ( int i = 0; i < shard_count; ++i ) {
+        std::lock_guard<std::mutex> lock( shards[i]->shard_mutex );
+        shards[i]->clear();
+    }
+}
+
+/////////////////////////////////////////////////////////////////////////
+//                      Private member functions                       //
+/////////////////////////////////////////////////////////////////////////
+
+// Return the shard of a key, chosen by the top shard_power bits of its hash value
+template <typename Key, typename Value, typename Hash>
+typename Sharded_lru_cache<Key, Value, Hash>::Shard &Sharded_lru_cache<Key, Value, Hash>::shard_of( Key const &key ) const {
+    std::uint64_t hash_value = static_cast<std::uint64_t>( hash_function( key ) );
+
+    return *shards[(shard_power == 0) ? 0 : static_cast<int>( hash_value >> (64 - shard_power) )];
+}
+
+#endif
@@ -0,0 +1,219 @@
+#ifndef CONCURRENT_HASH_TABLE_H
+#define CONCURRENT_HASH_TABLE_H
+
+#include <cstdint>
+#include <mutex>
+#include <shared_mutex>
+#include "Quadratic_hash_table.h"
+
+// std::shared_mutex is only available from C++17, C++14 has the slower timed version
+#if __cplusplus >= 201703L
+typedef std::shared_mutex Shard_mutex;
+#else
+typedef std::shared_timed_mutex Shard_mutex;
+#endif
+
+// A thread-safe set that splits the keys across 2^s independent Quadratic_hash_tables
+// The shard of a key is chosen by the high bits of its hash value, while each shard
+// uses the low bits to choose a bin, so the two choices do not interfere
+//
+// Every shard has its own reader/writer lock: lookups of different keys proceed in
+// parallel, and an insertion or erase only blocks operations on its own shard
+// Lookups never advance a rehash (only insert and erase do), so they can share a shard
+//
+// size(), capacity() and load_factor() lock each shard in turn, so under concurrent
+// modification they are only a snapshot
+template <typename Type, typename Hash = Mixing_hash<Type> >
+class Concurrent_hash_table {
+	private:
+		// One table and its lock, padded to a cache line of its own so that shards
+		// used by different threads do not share lines
+		class alignas(64) Shard : public Quadratic_hash_table<Type, Hash> {
+			public:
+				Shard( int, double, Hash const & );
+
+				mutable Shard_mutex shard_mutex;
+
+				// The hashed operations of the engine, made visible to the concurrent table
+				using Quadratic_hash_table<Type, Hash>::hash;
+				using Quadratic_hash_table<Type, Hash>::find_hashed;
+				using Quadratic_hash_table<Type, Hash>::emplace_hashed;
+				using Quadratic_hash_table<Type, Hash>::erase_slot;
+		};
+
+		int shard_power;
+		int shard_count;
+		Shard **shards;
+		Hash hash_function;
+
+		int shard_of( std::uint64_t ) const;
+
+		// The shards are owned by the table and are not shared between tables
+		Concurrent_hash_table( Concurrent_hash_table const & );
+		Concurrent_hash_table &operator=( Concurrent_hash_table const & );
+
+	public:
+		Concurrent_hash_table( int = 4, int = 5, double = 0.75, Hash const & = Hash() );
+		~Concurrent_hash_table();
+
+		int shards_count() const;
+		int size() const;
+		int capacity() const;
+		double load_factor() const;
+		bool empty() const;
+		bool member( Type const & ) const;
+
+		bool insert( Type const & );
+		bool erase( Type const & );
+		void clear();
+};
+
+/////////////////////////////////////////////////////////////////////////
+//                   Constructors and Destructors                      //
+/////////////////////////////////////////////////////////////////////////
+
+template <typename Type, typename Hash>
+Concurrent_hash_table<Type, Hash>::Shard::Shard( int m, double lf, Hash const &hf ):
+Quadratic_hash_table<Type, Hash>( m, lf, hf ) {
+	// empty constructor
+}
+
+// Constructor
+// Creates 2^s shards, each starting with 2^m bins and growing at load factor lf
+template <typename Type, typename Hash>
+Concurrent_hash_table<Type, Hash>::Concurrent_hash_table( int s, int m, double lf, Hash const &hf ):
+shard_power( (s >= 0 && s <= 16) ? s : 4 ),
+shard_count( 1 << shard_power ),
+shards( new Shard *[shard_count] ),
+hash_function( hf ) {
+    for ( int i = 0; i < shard_count; ++i ) {
+        shards[i] = new Shard( m, lf, hf );
+    }
+}
+
+// Destructor
+template <typename Type, typename Hash>
+Concurrent_hash_table<Type, Hash>::~Concurrent_hash_table() {
+    for ( int i = 0; i < shard_count; ++i ) {
+        delete shards[i];
+    }
+
+    delete [] shards;
+}
+
+/////////////////////////////////////////////////////////////////////////
+//                     Public Member Functions                         //
+/////////////////////////////////////////////////////////////////////////
+
+//ACCESSORS
+
+// Return the number of shards
+template <typename Type, typename Hash>
+int Concurrent_hash_table<Type, Hash>::shards_count() const {
+    return shard_count;
+}
+
+// Return the number of elements stored in all shards
+template <typename Type, typename Hash>
+int Concurrent_hash_table<Type, Hash>::size() const {
+    int total = 0;
+
+    for ( int i = 0; i < shard_count; ++i ) {
+        std::shared_lock<Shard_mutex> lock( shards[i]->shard_mutex );
+        total += shards[i]->size();
+    }
+
+    return total;
+}
+
+// Return the number of bins in all shards
+template <typename Type, typename Hash>
+int Concurrent_hash_table<Type, Hash>::capacity() const {
+    int total = 0;
+
+    for ( int i = 0; i < shard_count; ++i ) {
+        std::shared_lock<Shard_mutex> lock( shards[i]->shard_mutex );
+        total += shards[i]->capacity();
+    }
+
+    return total;
+}
+
+// Return the load factor over all shards
+template <typename Type, typename Hash>
+double Concurrent_hash_table<Type, Hash>::load_factor() const {
+    double used = 0.0;
+    double bins = 0.0;
+
+    for ( int i = 0; i < shard_count; ++i ) {
+        std::shared_lock<Shard_mutex> lock( shards[i]->shard_mutex );
+        used += shards[i]->load_factor() * shards[i]->capacity();
+        bins += shards[i]->capacity();
+    }
+
+    return used / bins;
+}
+
+// Return true if no shard holds an element
+template <typename Type, typename Hash>
+bool Concurrent_hash_table<Type, Hash>::empty() const {
+    return size() == 0;
+}
+
+// Return true if the argument object is in the hash table
+// Only the shard of the object is locked, and only for reading
+template <typename Type, typename Hash>
+bool Concurrent_hash_table<Type, Hash>::member( Type const &obj ) const {
+    std::uint64_t hash_value = static_cast<std::uint64_t>( hash_function( obj ) );
+    Shard const *shard = shards[shard_of( hash_value )];
+
+    std::shared_lock<Shard_mutex> lock( shard->shard_mutex );
+
+    return shard->find_hashed( obj, hash_value ) != nullptr;
+}
+
+//MUTATORS
+
+// Insert an object into the hash table
+// Returns true if it was inserted, false if it was already present
+template <typename Type, typename Hash>
+bool Concurrent_hash_table<Type, Hash>::insert( Type const &obj ) {
+    std::uint64_t hash_value = static_cast<std::uint64_t>( hash_function( obj ) );
+    Shard *shard = shards[shard_of( hash_value )];
+
+    std::unique_lock<Shard_mutex> lock( shard->shard_mutex );
+
+    return shard->emplace_hashed( obj, hash_value, obj ).second;
+}
+
+// Erases an object from the hash table and returns true on success, false otherwise
+template <typename Type, typename Hash>
+bool Concurrent_hash_table<Type, Hash>::erase( Type const &obj ) {
+    std::uint64_t hash_value = static_cast<std::uint64_t>( hash_function( obj ) );
+    Shard *shard = shards[shard_of( hash_value )];
+
+    std::unique_lock<Shard_mutex> lock( shard->shard_mutex );
+
+    return shard->erase_slot( obj );
+}
+
+// Clear every shard, one at a time
+template <typename Type, typename Hash>
+void Concurrent_hash_table<Type, Hash>::clear() {
+    for ( int i = 0; i < shard_count; ++i ) {
+        std::unique_lock<Shard_mutex> lock( shards[i]->shard_mutex );
+        shards[i]->clear();
+    }
+}
+
+/////////////////////////////////////////////////////////////////////////
+//                      Private member functions                       //
+/////////////////////////////////////////////////////////////////////////
+
+// Return the shard of a hash value, taken from its high bits
+template <typename Type, typename Hash>
+int Concurrent_hash_table<Type, Hash>::shard_of( std::uint64_t hash_value ) const {
+    return (shard_power == 0) ? 0 : static_cast<int>( hash_value >> (64 - shard_power) );
+}
+
+#endif
@@ -0,0 +1,109 @@
+// Multi-threaded throughput benchmark for Concurrent_hash_table
+//
+// Compares the sharded table against a single Quadratic_hash_table behind one global
+// mutex, for 1, 2, 4, ... threads up to the number of hardware threads
+// Each thread performs a mix of 90% member, 5% insert and 5% erase calls on random keys
+//
+// Build and run with, for example:
+//     g++ -std=c++17 -O2 -pthread Concurrent_hash_table_benchmark.cpp -o concurrent_benchmark
+//     ./concurrent_benchmark [operations per thread] [key range] [shard power] [maximum threads]
+
+#include <algorithm>
+#include <chrono>
+#include <cstdlib>
+#include <iostream>
+#include <mutex>
+#include <random>
+#include <thread>
+#include <vector>
+#include "Concurrent_hash_table.h"
+
+// A Quadratic_hash_table behind a single mutex, the arrangement being replaced
+class Locked_hash_table {
+	public:
+		bool member( long long key ) {
+		    std::lock_guard<std::mutex> lock( table_mutex );
+		    return table.member( key );
+		}
+
+		bool insert( long long key ) {
+		    std::lock_guard<std::mutex> lock( table_mutex );
+		    return table.insert( key ).second;
+		}
+
+		bool erase( long long key ) {
+		    std::lock_guard<std::mutex> lock( table_mutex );
+		    return table.erase( key );
+		}
+
+	private:
+		std::mutex table_mutex;
+		Quadratic_hash_table<long long> table;
+};
+
+// Run the operation mix on the table from the given number of threads
+// Returns the throughput in millions of operations per second
+template <typename Table>
+double run( Table &table, int threads, long operations, long long key_range ) {
+    std::vector<std::thread> workers;
+    auto start = std::chrono::steady_clock::now();
+
+    for ( int t = 0; t < threads; ++t ) {
+        workers.emplace_back( [&table, t, operations, key_range]() {
+            std::mt19937_64 random( 12345 + t );
+            long hits = 0;
+
+            for ( long i = 0; i < operations; ++i ) {
+                long long key = static_cast<long long>( random() % key_range );
+                int choice = static_cast<int>( random() % 100 );
+
+                if ( choice < 90 ) {
+                    hits += table.member( key );
+                } else if ( choice < 95 ) {
+                    table.insert( key );
+                } else {
+                    table.erase( key );
+                }
+            }
+
+            // Keep the lookups from being optimized away
+            if ( hits < 0 )
+                std::cout << hits;
+        } );
+    }
+
+    for ( std::thread &worker : workers ) {
+        worker.join();
+    }
+
+    std::chrono::duration<double> elapsed = std::chrono::steady_clock::now() - start;
+
+    return threads * operations / elapsed.count() / 1e6;
+}
+
+int main( int argc, char **argv ) {
+    long operations = (argc > 1) ? std::atol( argv[1] ) : 2000000;
+    long long key_range = (argc > 2) ? std::atoll( argv[2] ) : 1000000;
+    int shard_power = (argc > 3) ? std::atoi( argv[3] ) : 6;
+    int max_threads = (argc > 4) ? std::atoi( argv[4] ) : std::max( 1, static_cast<int>( std::thread::hardware_concurrency() ) );
+
+    std::cout << "threads  global mutex (Mops/s)  sharded (Mops/s)" << std::endl;
+
+    for ( int threads = 1; threads <= max_threads; threads *= 2 ) {
+        Locked_hash_table locked;
+        Concurrent_hash_table<long long> sharded( shard_power );
+
+        // Start both tables half full
+        for ( long long key = 0; key < key_range; key += 2 ) {
+            locked.insert( key );
+            sharded.insert( key );
+        }
+
+        double locked_rate = run( locked, threads, operations, key_range );
+        double sharded_rate = run( sharded, threads, operations, key_range );
+
+        std::cout << threads << "        " << locked_rate << "                " << sharded_rate << std::endl;
+    }
+
+    return 0;
+}
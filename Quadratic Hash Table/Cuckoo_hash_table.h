@@ -0,0 +1,513 @@
+#ifndef CUCKOO_HASH_TABLE_H
+#define CUCKOO_HASH_TABLE_H
+
+// nullptr is a keyword rather than a macro, so only fall back to 0 on pre-C++11 compilers
+#if __cplusplus < 201103L && !defined(nullptr)
+#define nullptr 0
+#endif
+
+#include <cstdint>
+#include <new>
+#include <type_traits>
+#include <utility>
+#include <vector>
+#include "Exception.h"
+#include "ece250.h"
+#include "Hash_function.h"
+
+// A set of objects stored with bucketized cuckoo hashing
+// It has the same interface as Quadratic_hash_table
+//
+// Every object lives in one of two buckets of SLOTS bins, chosen by different bits of its
+// hash value, so a lookup inspects at most two buckets however full the table is
+// Each bucket keeps a one-byte fingerprint per bin next to its objects, and is aligned to a
+// cache line, so for small objects a lookup touches at most two cache lines
+//
+// Insertion that finds both buckets full moves an object out of the way to its other
+// bucket, and so on for up to MAX_DISPLACEMENTS moves before the table grows
+// An object that still has no bin after growing (which needs many keys with colliding
+// hash values) is kept in a small stash that lookups only scan when it is not empty
+template <typename Type, typename Hash = Mixing_hash<Type> >
+class Cuckoo_hash_table {
+	private:
+		// Number of bins in each bucket
+		static const int SLOTS = 4;
+		static const int SLOT_POWER = 2;
+
+		// Number of objects moved by one insertion before the table grows instead
+		static const int MAX_DISPLACEMENTS = 128;
+
+		// SLOTS bins with their fingerprints, 0 marking an empty bin
+		class alignas(64) Bucket {
+			public:
+				std::uint8_t fingerprint[SLOTS];
+				typename std::aligned_storage<sizeof( Type ), alignof( Type )>::type storage[SLOTS];
+
+				Type &slot( int i ) {
+				    return *reinterpret_cast<Type *>( storage + i );
+				}
+
+				Type const &slot( int i ) const {
+				    return *reinterpret_cast<Type const *>( storage + i );
+				}
+		};
+
+		int count;
+		int power;
+		int bucket_count;
+		int mask;
+		Bucket *buckets;
+		void *bucket_memory;            // The allocation holding the buckets, which starts at most one bucket before them
+		std::vector<Type> stash;
+		Hash hash_function;
+		double max_load;
+
+		std::uint64_t hash( Type const & ) const;
+		int first_bucket( std::uint64_t ) const;
+		int second_bucket( std::uint64_t ) const;
+		static std::uint8_t fingerprint_of( std::uint64_t );
+		int find( Type const & ) const;
+		int find_in( int, Type const &, std::uint8_t ) const;
+		bool is_occupied( int ) const;
+		int place( Type & );
+		void rehash( int );
+
+		static Bucket *allocate_buckets( int, void *& );
+		static void release( Bucket *, void *, int );
+
+		// The buckets are owned by the table and are not shared between tables
+		Cuckoo_hash_table( Cuckoo_hash_table const & );
+		Cuckoo_hash_table &operator=( Cuckoo_hash_table const & );
+
+	public:
+		Cuckoo_hash_table( int = 5, double = 0.9, Hash const & = Hash() );
+		~Cuckoo_hash_table();
+		int size() const;
+		int capacity() const;
+		double load_factor() const;
+		double max_load_factor() const;
+		bool empty() const;
+		bool member( Type const & ) const;
+		Type bin( int ) const;
+
+		void print() const;
+
+		void max_load_factor( double );
+		std::pair<int, bool> insert( Type const & );
+		bool erase( Type const & );
+		void clear();
+
+	// Friends
+
+	template <typename T, typename H>
+	friend std::ostream &operator<<( std::ostream &, Cuckoo_hash_table<T, H> const & );
+};
+
+/////////////////////////////////////////////////////////////////////////
+//                   Constructors and Destructors                      //
+/////////////////////////////////////////////////////////////////////////
+
+// Constructor
+// The table starts with 2^m bins, or 2^5 if m is too small for one bucket or larger than 30,
+// grouped into buckets of SLOTS
+// power is the power of 2 of the number of buckets
+template <typename Type, typename Hash>
+Cuckoo_hash_table<Type, Hash>::Cuckoo_hash_table( int m, double lf, Hash const &hf ):
+count( 0 ),
+power( ((m >= SLOT_POWER && m <= 30) ? m : 5) - SLOT_POWER ),
+bucket_count( 1 << power ),
+mask( bucket_count - 1 ),
+buckets( nullptr ),
+bucket_memory( nullptr ),
+hash_function( hf ),
+max_load( lf ) {
+    // Displacement needs some free bins to move objects into
+    if ( lf <= 0.0 || lf >= 1.0 ) {
+        throw illegal_argument();
+    }
+
+    buckets = allocate_buckets( bucket_count, bucket_memory );
+}
+
+// Destructor
+template <typename Type, typename Hash>
+Cuckoo_hash_table<Type, Hash>::~Cuckoo_hash_table() {
+    release( buckets, bucket_memory, bucket_count );
+}
+
+/////////////////////////////////////////////////////////////////////////
+//                     Public Member Functions                         //
+/////////////////////////////////////////////////////////////////////////
+
+//ACCESSORS
+
+// Return the number of elements stored in the hash table
+template <typename Type, typename Hash>
+int Cuckoo_hash_table<Type, Hash>::size() const {
+    return count;
+}
+
+// Return the number of bins in the hash table
+template <typename Type, typename Hash>
+int Cuckoo_hash_table<Type, Hash>::capacity() const {
+    return bucket_count * SLOTS;
+}
+
+// Return the load factor of the hash table
+template <typename Type, typename Hash>
+double Cuckoo_hash_table<Type, Hash>::load_factor() const {
+    return static_cast<double>(count) / static_cast<double>(capacity());
+}
+
+// Return the load factor at which the hash table grows
+template <typename Type, typename Hash>
+double Cuckoo_hash_table<Type, Hash>::max_load_factor() const {
+    return max_load;
+}
+
+// Return true if the hash table is empty, false otherwise
+template <typename Type, typename Hash>
+bool Cuckoo_hash_table<Type, Hash>::empty() const {
+    return size() == 0;
+}
+
+// Return true if the argument object is in the hash table
+template <typename Type, typename Hash>
+bool Cuckoo_hash_table<Type, Hash>::member( Type const &obj ) const {
+    return find( obj ) != -1;
+}
+
+// Return the content of bin n, or a default object if the bin is empty
+// Bin n is slot n % SLOTS of bucket n / SLOTS
+template <typename Type, typename Hash>
+Type Cuckoo_hash_table<Type, Hash>::bin( int n ) const {
+    return is_occupied( n ) ? buckets[n >> SLOT_POWER].slot( n & (SLOTS - 1) ) : Type();
+}
+
+// Print contents in all occupied bins, null otherwise, followed by any stashed objects
+template <typename Type, typename Hash>
+void Cuckoo_hash_table<Type, Hash>::print() const {
+    for ( int i = 0; i < capacity(); i++ ) {
+        std::cout << "bin(" << i << "): ";
+
+        if ( is_occupied( i ) ) {
+            std::cout << bin( i ) << std::endl;
+        } else {
+            std::cout << "null" << std::endl;
+        }
+    }
+
+    for ( std::size_t i = 0; i < stash.size(); i++ ) {
+        std::cout << "stash(" << i << "): " << stash[i] << std::endl;
+    }
+}
+
+//MUTATORS
+
+// Set the load factor at which the hash table grows
+// The new limit takes effect on the next insertion
+template <typename Type, typename Hash>
+void Cuckoo_hash_table<Type, Hash>::max_load_factor( double lf ) {
+    if ( lf <= 0.0 || lf >= 1.0 )
+        throw illegal_argument();
+
+    max_load = lf;
+}
+
+// Insert an object into the hash table
+// Returns the bin holding the object and true if it was inserted, false if it was already present
+// The bin is -1 for an object held in the stash
+template <typename Type, typename Hash>
+std::pair<int, bool> Cuckoo_hash_table<Type, Hash>::insert( Type const &obj ) {
+    int found = find( obj );
+
+    if ( found != -1 )
+        return std::make_pair( (found >= 0) ? found : -1, false );
+
+    if ( count + 1 > max_load * capacity() )
+        rehash( power + 1 );
+
+    Type carried( obj );
+    int bin = place( carried );
+
+    // Displacement went on too long: grow, then place whichever object was left without a bin
+    // Below half the maximum load a failure means colliding hash values rather than a full
+    // table, and growing would not separate them, so the object goes straight to the stash
+    if ( bin == -1 ) {
+        if ( count >= max_load * capacity() / 2 )
+            rehash( power + 1 );
+
+        if ( place( carried ) == -1 )
+            stash.push_back( std::move( carried ) );
+    }
+
+    count++;
+
+    // After growing, the argument object may be anywhere, so look up where it ended up
+    if ( bin == -1 ) {
+        bin = find( obj );
+    }
+
+    return std::make_pair( (bin >= 0) ? bin : -1, true );
+}
+
+// Erases an object from the hash table and returns true on success, false otherwise
+template <typename Type, typename Hash>
+bool Cuckoo_hash_table<Type, Hash>::erase( Type const &obj ) {
+    int bin = find( obj );
+
+    if ( bin == -1 )
+        return false;
+
+    if ( bin < -1 ) {
+        // find() returns -2 - i for stash[i]
+        if ( -2 - bin != static_cast<int>( stash.size() ) - 1 )
+            stash[-2 - bin] = std::move( stash.back() );
+
+        stash.pop_back();
+    } else {
+        Bucket &bucket = buckets[bin >> SLOT_POWER];
+
+        bucket.slot( bin & (SLOTS - 1) ).~Type();
+        bucket.fingerprint[bin & (SLOTS - 1)] = 0;
+    }
+
+    count--;
+
+    return true;
+}
+
+// Clear all elements in the hash table by destroying them and marking every bin empty
+template <typename Type, typename Hash>
+void Cuckoo_hash_table<Type, Hash>::clear() {
+    for ( int b = 0; b < bucket_count; b++ ) {
+        for ( int i = 0; i < SLOTS; i++ ) {
+            if ( buckets[b].fingerprint[i] != 0 )
+                buckets[b].slot( i ).~Type();
+
+            buckets[b].fingerprint[i] = 0;
+        }
+    }
+
+    stash.clear();
+    count = 0;
+}
+
+/////////////////////////////////////////////////////////////////////////
+//                      Private member functions                       //
+/////////////////////////////////////////////////////////////////////////
+
+// Hash function that returns the full hash value of an object
+template <typename Type, typename Hash>
+std::uint64_t Cuckoo_hash_table<Type, Hash>::hash( Type const &obj ) const {
+    return static_cast<std::uint64_t>( hash_function( obj ) );
+}
+
+// The first bucket of a hash value is taken from its low bits
+template <typename Type, typename Hash>
+int Cuckoo_hash_table<Type, Hash>::first_bucket( std::uint64_t hash_value ) const {
+    return static_cast<int>( hash_value & mask );
+}
+
+// The second bucket of a hash value is taken from its high 32 bits, acting as a second hash function
+template <typename Type, typename Hash>
+int Cuckoo_hash_table<Type, Hash>::second_bucket( std::uint64_t hash_value ) const {
+    return static_cast<int>( (hash_value >> 32) & mask );
+}
+
+// The fingerprint of a hash value is never 0, and is the exclusive or of bits 24-31, which
+// only the first bucket index uses and only once there are more than 2^24 buckets, and
+// bits 56-63, which only the second bucket index uses, in the same case
+// Objects share a bucket because they share one of the two indices, and the byte that index
+// cannot use still varies among them, so their fingerprints stay spread out however large
+// the table grows
+template <typename Type, typename Hash>
+std::uint8_t Cuckoo_hash_table<Type, Hash>::fingerprint_of( std::uint64_t hash_value ) {
+    std::uint8_t fingerprint = static_cast<std::uint8_t>( (hash_value >> 24) ^ (hash_value >> 56) );
+
+    return (fingerprint == 0) ? 1 : fingerprint;
+}
+
+// Return the bin holding the argument object, -2 - i if it is stash[i], or -1 if it is not in the hash table
+template <typename Type, typename Hash>
+int Cuckoo_hash_table<Type, Hash>::find( Type const &obj ) const {
+    std::uint64_t hash_value = hash( obj );
+    std::uint8_t fingerprint = fingerprint_of( hash_value );
+
+    int bin = find_in( first_bucket( hash_value ), obj, fingerprint );
+
+    if ( bin == -1 )
+        bin = find_in( second_bucket( hash_value ), obj, fingerprint );
+
+    if ( bin == -1 ) {
+        for ( std::size_t i = 0; i < stash.size(); i++ ) {
+            if ( stash[i] == obj )
+                return -2 - static_cast<int>( i );
+        }
+    }
+
+    return bin;
+}
+
+// Return the bin of bucket b holding the argument object, or -1 if it is not there
+// Only bins whose fingerprint matches are compared
+template <typename Type, typename Hash>
+int Cuckoo_hash_table<Type, Hash>::find_in( int b, Type const &obj, std::uint8_t fingerprint ) const {
+    Bucket const &bucket = buckets[b];
+
+    for ( int i = 0; i < SLOTS; i++ ) {
+        if ( bucket.fingerprint[i] == fingerprint && bucket.slot( i ) == obj )
+            return (b << SLOT_POWER) + i;
+    }
+
+    return -1;
+}
+
+// Return true if bin n holds an object
+template <typename Type, typename Hash>
+bool Cuckoo_hash_table<Type, Hash>::is_occupied( int n ) const {
+    return buckets[n >> SLOT_POWER].fingerprint[n & (SLOTS - 1)] != 0;
+}
+
+// Move an object known not to be in the hash table into a bin, displacing others as needed
+// Returns the bin the object was moved into, or -1 if MAX_DISPLACEMENTS objects were moved
+// without finding an empty bin, in which case the object left without a bin is in obj
+// The count is not changed
+template <typename Type, typename Hash>
+int Cuckoo_hash_table<Type, Hash>::place( Type &obj ) {
+    std::uint64_t hash_value = hash( obj );
+    int b = first_bucket( hash_value );
+    int alternate = second_bucket( hash_value );
+    int first_bin = -1;
+
+    for ( int moves = 0; moves <= MAX_DISPLACEMENTS; moves++ ) {
+        std::uint8_t fingerprint = fingerprint_of( hash_value );
+
+        // Look for an empty bin in either bucket of the object being carried
+        for ( int k = 0; k < 2; k++ ) {
+            Bucket &bucket = buckets[(k == 0) ? b : alternate];
+
+            for ( int i = 0; i < SLOTS; i++ ) {
+                if ( bucket.fingerprint[i] == 0 ) {
+                    new ( &bucket.slot( i ) ) Type( std::move( obj ) );
+                    bucket.fingerprint[i] = fingerprint;
+
+                    int bin = ((k == 0 ? b : alternate) << SLOT_POWER) + i;
+
+                    return (first_bin >= 0) ? first_bin : bin;
+                }
+            }
+        }
+
+        // Both buckets are full: swap the carried object with one in its alternate bucket,
+        // varying the choice of bin so that repeated moves do not cycle
+        int i = (moves + fingerprint) & (SLOTS - 1);
+        Bucket &bucket = buckets[alternate];
+
+        int bin = (alternate << SLOT_POWER) + i;
+
+        std::swap( obj, bucket.slot( i ) );
+        bucket.fingerprint[i] = fingerprint;
+
+        // The first object placed is the argument, unless it has just been displaced in turn
+        if ( first_bin < 0 ) {
+            first_bin = bin;
+        } else if ( first_bin == bin ) {
+            first_bin = -1;
+        }
+
+        // Carry the displaced object on to whichever of its buckets it was not in
+        hash_value = hash( obj );
+        b = alternate;
+        alternate = (first_bucket( hash_value ) == b) ? second_bucket( hash_value ) : first_bucket( hash_value );
+    }
+
+    return -1;
+}
+
+// Move every object into 2^p new buckets
+// The buckets are allocated before anything is changed, and growing past 2^30 bins throws overflow
+template <typename Type, typename Hash>
+void Cuckoo_hash_table<Type, Hash>::rehash( int p ) {
+    if ( p + SLOT_POWER > 30 )
+        throw overflow();
+
+    void *new_memory;
+    Bucket *new_buckets = allocate_buckets( 1 << p, new_memory );
+
+    Bucket *old_buckets = buckets;
+    void *old_memory = bucket_memory;
+    int old_bucket_count = bucket_count;
+    std::vector<Type> old_stash;
+
+    old_stash.swap( stash );
+    power = p;
+    bucket_count = 1 << power;
+    mask = bucket_count - 1;
+    buckets = new_buckets;
+    bucket_memory = new_memory;
+
+    for ( int b = 0; b < old_bucket_count; b++ ) {
+        for ( int i = 0; i < SLOTS; i++ ) {
+            if ( old_buckets[b].fingerprint[i] != 0 && place( old_buckets[b].slot( i ) ) == -1 ) {
+                // The object left over has been moved out of, so it is carried into the stash
+                stash.push_back( std::move( old_buckets[b].slot( i ) ) );
+            }
+        }
+    }
+
+    for ( std::size_t i = 0; i < old_stash.size(); i++ ) {
+        if ( place( old_stash[i] ) == -1 )
+            stash.push_back( std::move( old_stash[i] ) );
+    }
+
+    release( old_buckets, old_memory, old_bucket_count );
+}
+
+// Allocate n buckets with every bin empty, aligned to a cache line
+// Before C++17 operator new does not honour the alignment of Bucket, so the buckets are
+// placed at the first aligned address of an allocation one bucket larger, set in memory
+template <typename Type, typename Hash>
+typename Cuckoo_hash_table<Type, Hash>::Bucket *Cuckoo_hash_table<Type, Hash>::allocate_buckets( int n, void *&memory ) {
+    memory = ::operator new( (n + 1) * sizeof( Bucket ) );
+
+    std::uintptr_t address = reinterpret_cast<std::uintptr_t>( memory );
+    std::uintptr_t alignment = alignof( Bucket );
+    Bucket *new_buckets = reinterpret_cast<Bucket *>( (address + alignment - 1) & ~(alignment - 1) );
+
+    for ( int b = 0; b < n; ++b ) {
+        for ( int i = 0; i < SLOTS; ++i ) {
+            new_buckets[b].fingerprint[i] = 0;
+        }
+    }
+
+    return new_buckets;
+}
+
+// Destroy the objects in all occupied bins and free the buckets
+template <typename Type, typename Hash>
+void Cuckoo_hash_table<Type, Hash>::release( Bucket *old_buckets, void *memory, int n ) {
+    for ( int b = 0; b < n; ++b ) {
+        for ( int i = 0; i < SLOTS; ++i ) {
+            if ( old_buckets[b].fingerprint[i] != 0 )
+                old_buckets[b].slot( i ).~Type();
+        }
+    }
+
+    ::operator delete( memory );
+}
+
+template <typename T, typename H>
+std::ostream &operator<<( std::ostream &out, Cuckoo_hash_table<T, H> const &hash ) {
+	for ( int i = 0; i < hash.capacity(); ++i ) {
+		if ( !hash.is_occupied( i ) ) {
+			out << "- ";
+		} else {
+			out << hash.bin( i ) << ' ';
+		}
+	}
+
+	return out;
+}
+
+#endif
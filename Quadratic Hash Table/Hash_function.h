@@ -0,0 +1,128 @@
+#ifndef HASH_FUNCTION_H
+#define HASH_FUNCTION_H
+
+#include <cstdint>
+#include <cstring>
+#include <functional>
+#include <string>
+#include <type_traits>
+
+#if __cplusplus >= 201703L
+#include <string_view>
+#endif
+
+/////////////////////////////////////////////////////////////////////////
+//                          Mixing functions                           //
+/////////////////////////////////////////////////////////////////////////
+
+// 64-bit finalizer from MurmurHash3
+// Every input bit affects every output bit, so keys that only differ in a few
+// (possibly high) bits still land in unrelated bins once the hash is masked down
+inline std::uint64_t mix_hash( std::uint64_t h ) {
+    h ^= h >> 33;
+    h *= 0xff51afd7ed558ccdULL;
+    h ^= h >> 33;
+    h *= 0xc4ceb9fe1a85ec53ULL;
+    h ^= h >> 33;
+
+    return h;
+}
+
+// Hash a run of bytes eight at a time, folding each word in with a multiply and
+// finishing with mix_hash() so that short strings are as well spread as integers
+inline std::uint64_t mix_hash( char const *bytes, std::size_t length ) {
+    std::uint64_t h = 0x9e3779b97f4a7c15ULL ^ length;
+
+    while ( length >= 8 ) {
+        std::uint64_t word;
+        std::memcpy( &word, bytes, 8 );
+        h = (h ^ mix_hash( word )) * 0x9fb21c651e98df25ULL;
+        bytes += 8;
+        length -= 8;
+    }
+
+    if ( length > 0 ) {
+        std::uint64_t word = 0;
+        std::memcpy( &word, bytes, length );
+        h = (h ^ mix_hash( word )) * 0x9fb21c651e98df25ULL;
+    }
+
+    return mix_hash( h );
+}
+
+/////////////////////////////////////////////////////////////////////////
+//                           Hash functors                             //
+/////////////////////////////////////////////////////////////////////////
+
+// Default hash functor for the hash tables
+// Returns a full 64-bit hash value; the tables reduce it to a bin with a bit mask
+// Any type supported by std::hash works, its result is passed through mix_hash()
+// because std::hash of an integer is usually the integer itself
+template <typename Type, typename = void>
+class Mixing_hash {
+	public:
+		std::uint64_t operator()( Type const &obj ) const {
+		    return mix_hash( static_cast<std::uint64_t>( std::hash<Type>()( obj ) ) );
+		}
+};
+
+// Integers and enumerations are mixed directly
+template <typename Type>
+class Mixing_hash<Type, typename std::enable_if<std::is_integral<Type>::value || std::is_enum<Type>::value>::type> {
+	public:
+		std::uint64_t operator()( Type obj ) const {
+		    return mix_hash( static_cast<std::uint64_t>( obj ) );
+		}
+};
+
+// Floating point values are hashed by their bit pattern so that values with the same
+// integer part no longer collide; 0.0 and -0.0 compare equal and must hash equal
+template <>
+class Mixing_hash<double> {
+	public:
+		std::uint64_t operator()( double obj ) const {
+		    std::uint64_t bits = 0;
+
+		    if ( obj != 0.0 ) {
+		        std::memcpy( &bits, &obj, sizeof( obj ) );
+		    }
+
+		    return mix_hash( bits );
+		}
+};
+
+template <>
+class Mixing_hash<float> {
+	public:
+		std::uint64_t operator()( float obj ) const {
+		    return Mixing_hash<double>()( obj );
+		}
+};
+
+// Strings hash their characters, so a std::string and a std::string_view (or a
+// null-terminated character array) with the same contents hash to the same value
+template <>
+class Mixing_hash<std::string> {
+	public:
+		std::uint64_t operator()( std::string const &obj ) const {
+		    return mix_hash( obj.data(), obj.size() );
+		}
+
+		std::uint64_t operator()( char const *obj ) const {
+		    return mix_hash( obj, std::strlen( obj ) );
+		}
+
+#if __cplusplus >= 201703L
+		std::uint64_t operator()( std::string_view obj ) const {
+		    return mix_hash( obj.data(), obj.size() );
+		}
+#endif
+};
+
+#if __cplusplus >= 201703L
+template <>
+class Mixing_hash<std::string_view> : public Mixing_hash<std::string> {
+};
+#endif
+
+#endif
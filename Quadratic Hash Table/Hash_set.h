@@ -0,0 +1,37 @@
+#ifndef HASH_SET_H
+#define HASH_SET_H
+
+#include "Cuckoo_hash_table.h"
+#include "Quadratic_hash_table.h"
+#include "Robin_hood_hash_table.h"
+
+// Probing policies for Hash_set
+// Each policy names the table that implements it; all of them share the interface of Quadratic_hash_table
+
+// Quadratic probing with ERASED markers and an incremental rehash
+class Quadratic_probing {
+	public:
+		template <typename Type, typename Hash>
+		using table = Quadratic_hash_table<Type, Hash>;
+};
+
+// Linear probing with Robin Hood displacement and backward-shift deletion, which never leaves ERASED markers
+class Robin_hood_probing {
+	public:
+		template <typename Type, typename Hash>
+		using table = Robin_hood_hash_table<Type, Hash>;
+};
+
+// Bucketized cuckoo hashing, whose lookups inspect at most two buckets
+class Cuckoo_probing {
+	public:
+		template <typename Type, typename Hash>
+		using table = Cuckoo_hash_table<Type, Hash>;
+};
+
+// A hash set whose probing scheme is selected by a policy, for example
+//     Hash_set<int, Robin_hood_probing> sessions;
+template <typename Type, typename Probing = Quadratic_probing, typename Hash = Mixing_hash<Type> >
+using Hash_set = typename Probing::template table<Type, Hash>;
+
+#endif
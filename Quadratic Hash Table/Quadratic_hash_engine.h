@@ -0,0 +1,1161 @@
+#ifndef QUADRATIC_HASH_ENGINE_H
+#define QUADRATIC_HASH_ENGINE_H
+
+// nullptr is a keyword rather than a macro, so only fall back to 0 on pre-C++11 compilers
+// Redefining it otherwise breaks standard headers such as <string_view>
+#if __cplusplus < 201103L && !defined(nullptr)
+#define nullptr 0
+#endif
+
+#include <cstddef>
+#include <cstdint>
+#include <iterator>
+#include <new>
+#include <thread>
+#include <type_traits>
+#include <utility>
+#include <vector>
+#include "Exception.h"
+#include "ece250.h"
+#include "Hash_function.h"
+
+enum bin_state_t { UNOCCUPIED, OCCUPIED, ERASED };
+
+// The cumulative insert, erase and rehash counters cost a few increments on every
+// modification, so they are only kept when QUADRATIC_HASH_STATS is defined
+#ifdef QUADRATIC_HASH_STATS
+#define QUADRATIC_HASH_COUNT( counter ) ++(counter)
+#else
+#define QUADRATIC_HASH_COUNT( counter )
+#endif
+
+// A snapshot of the occupancy and probe lengths of a hash table, returned by stats()
+// A probe length is the number of bins visited, so a key found in its home bin has length 1
+class Hash_table_stats {
+	public:
+		Hash_table_stats();
+
+		// Bins of the current arrays
+		int capacity;
+		int live;
+		int erased;
+		int empty;
+
+		// Objects still waiting in the previous arrays of a rehash in progress
+		int pending;
+
+		// hit_probe_lengths[k] is the number of objects in the current arrays found by a probe of length k
+		// miss_probe_lengths[k] is the number of home bins from which a probe for an absent key has length k,
+		// so with a well-mixed hash it is proportional to the chance of a miss taking k probes
+		std::vector<int> hit_probe_lengths;
+		std::vector<int> miss_probe_lengths;
+		double average_hit_probe;
+		double average_miss_probe;
+		int max_hit_probe;
+		int max_miss_probe;
+
+		// Counted since construction; always 0 unless QUADRATIC_HASH_STATS is defined
+		long inserts;
+		long erases;
+		long rehashes;
+};
+
+// The open-addressing engine shared by Quadratic_hash_table and Quadratic_hash_map
+//
+// Slots are stored in raw arrays and are only constructed while their bin is OCCUPIED,
+// so a slot type does not need a default constructor and may be move-only
+// Key_of::key( slot ) returns the part of a slot that is hashed and compared
+//
+// Once (size + ERASED bins) would exceed the maximum load factor, insertion starts a
+// rehash into fresh arrays and the previous arrays are migrated a few bins at a time
+// by later operations, so no single call pays for an O(capacity) rehash
+//
+// Each bin state is tagged with the epoch in which it was written, and a tag from any
+// other epoch reads as UNOCCUPIED, so clear() empties the bins by starting a new epoch
+//
+// A bitmap with one bit per OCCUPIED bin of the current arrays lets iteration skip
+// 64 empty or ERASED bins at a time; each 64-bit word is tagged with an epoch in the same way
+template <typename Slot, typename Key, typename Key_of, typename Hash>
+class Quadratic_hash_engine {
+	public:
+		class const_iterator;
+		typedef const_iterator iterator;
+
+		Quadratic_hash_engine( int, double, Hash const & );
+		~Quadratic_hash_engine();
+
+		int size() const;
+		int capacity() const;
+		double load_factor() const;
+		double max_load_factor() const;
+		bool empty() const;
+
+		const_iterator begin() const;
+		const_iterator end() const;
+
+		Hash_table_stats stats() const;
+
+		void max_load_factor( double );
+		void clear();
+
+	protected:
+		int count;
+		mutable int countErased;
+		int power;
+		int array_size;
+		int mask;
+		Slot *array;
+		// (epoch << 2) | state for each bin; see state_of()
+		std::uint32_t *tags;
+		Hash hash_function;
+
+		// Incremented by clear(); only tags written in the current epoch are meaningful
+		std::uint32_t epoch;
+
+		// Bit i % 64 of occupancy[i / 64] is set if bin i is OCCUPIED, for words whose
+		// occupancy_epochs entry matches the current epoch; other words read as 0
+		std::uint64_t *occupancy;
+		std::uint32_t *occupancy_epochs;
+
+		// Growth is triggered once (count + countErased) exceeds max_load*array_size
+		double max_load;
+
+		// While a rehash is in progress the previous arrays are kept alive and their
+		// bins are migrated into the current arrays a few at a time
+		// Migration does not change the contents of the table, so lookups may advance it
+		mutable int old_array_size;
+		mutable int old_count;
+		mutable int migrate_bin;
+		mutable Slot *old_array;
+		mutable std::uint32_t *old_tags;
+
+#ifdef QUADRATIC_HASH_STATS
+		long inserts;
+		long erases;
+		long rehashes;
+#endif
+
+		// Number of old bins migrated by each call that pays for a slice of a rehash
+		static const int MIGRATE_STEP = 8;
+
+		// Number of keys whose bins are prefetched together by the batched operations
+		static const int BATCH_SIZE = 32;
+
+		// Epochs wrap back to 0 here, leaving room for the state in the low 2 bits of a tag
+		static const std::uint32_t EPOCH_LIMIT = 1u << 30;
+
+		// build() only splits the work across threads for at least this many objects,
+		// and gives every thread a region of at least PARALLEL_REGION_MIN bins
+		static const std::size_t PARALLEL_BUILD_MIN = 1 << 16;
+		static const int PARALLEL_REGION_MIN = 1 << 12;
+
+		bin_state_t state_of( std::uint32_t ) const;
+		std::uint32_t tag_of( bin_state_t ) const;
+		bin_state_t state( int ) const;
+		std::uint64_t occupancy_word( int ) const;
+		void mark_occupied( int, bool ) const;
+		int next_occupied( int ) const;
+
+		std::uint64_t hash( Key const & ) const;
+		int probe_length( int, int ) const;
+		int find_bin( Slot const *, std::uint32_t const *, int, Key const &, std::uint64_t, int * ) const;
+		Slot *find_slot( Key const & ) const;
+		Slot *find_hashed( Key const &, std::uint64_t ) const;
+		template <typename... Args>
+		std::pair<Slot *, bool> emplace_slot( Key const &, Args &&... );
+		template <typename... Args>
+		std::pair<Slot *, bool> emplace_hashed( Key const &, std::uint64_t, Args &&... );
+		void prefetch_hashed( std::uint64_t ) const;
+		bool erase_slot( Key const & );
+
+		bool rehashing() const;
+		void start_rehash();
+		void migrate( int ) const;
+		void finish_rehash() const;
+		template <typename... Args>
+		Slot *place( std::uint64_t, Args &&... ) const;
+		template <typename... Args>
+		Slot *construct_at( int, Args &&... ) const;
+
+		void reserve_empty( std::size_t );
+		template <typename Iterator>
+		void build( Iterator, Iterator );
+		template <typename Iterator>
+		void build( Iterator, Iterator, std::input_iterator_tag );
+		template <typename Iterator>
+		void build( Iterator, Iterator, std::forward_iterator_tag );
+		template <typename Iterator>
+		void build( Iterator, Iterator, std::random_access_iterator_tag );
+		template <typename Iterator>
+		int build_region( Iterator, std::uint64_t const *, std::size_t const *, std::size_t, std::size_t,
+		                  int, int, std::vector<std::size_t> & );
+		template <typename Function>
+		static void run_in_parallel( int, Function );
+
+		static Slot *allocate_slots( int );
+		static std::uint32_t *allocate_tags( int );
+		static void allocate_occupancy( int, std::uint64_t *&, std::uint32_t *& );
+		void release( Slot *, std::uint32_t *, int ) const;
+
+	private:
+		// The arrays are owned by the engine and are not shared between tables
+		Quadratic_hash_engine( Quadratic_hash_engine const & );
+		Quadratic_hash_engine &operator=( Quadratic_hash_engine const & );
+};
+
+// A forward iterator over the OCCUPIED bins of the current arrays
+// Any insertion or erase may invalidate it, as may clear()
+template <typename Slot, typename Key, typename Key_of, typename Hash>
+class Quadratic_hash_engine<Slot, Key, Key_of, Hash>::const_iterator {
+	public:
+		typedef std::forward_iterator_tag iterator_category;
+		typedef Slot value_type;
+		typedef std::ptrdiff_t difference_type;
+		typedef Slot const *pointer;
+		typedef Slot const &reference;
+
+		const_iterator():
+		table( nullptr ), bin( 0 ) {
+			// empty constructor
+		}
+
+		const_iterator( Quadratic_hash_engine const *t, int n ):
+		table( t ), bin( n ) {
+			// empty constructor
+		}
+
+		reference operator*() const {
+		    return table->array[bin];
+		}
+
+		pointer operator->() const {
+		    return table->array + bin;
+		}
+
+		const_iterator &operator++() {
+		    bin = table->next_occupied( bin + 1 );
+		    return *this;
+		}
+
+		const_iterator operator++( int ) {
+		    const_iterator previous( *this );
+		    ++*this;
+		    return previous;
+		}
+
+		bool operator==( const_iterator const &other ) const {
+		    return table == other.table && bin == other.bin;
+		}
+
+		bool operator!=( const_iterator const &other ) const {
+		    return !(*this == other);
+		}
+
+	private:
+		Quadratic_hash_engine const *table;
+		int bin;
+};
+
+// Return the index of the lowest set bit of a non-zero word
+inline int lowest_bit( std::uint64_t bits ) {
+#if defined(__GNUC__)
+    return __builtin_ctzll( bits );
+#else
+    int i = 0;
+
+    while ( (bits & 1) == 0 ) {
+        bits >>= 1;
+        ++i;
+    }
+
+    return i;
+#endif
+}
+
+// Key_of for tables whose slots are their own keys
+template <typename Type>
+class Identity_key {
+	public:
+		static Type const &key( Type const &obj ) {
+		    return obj;
+		}
+};
+
+/////////////////////////////////////////////////////////////////////////
+//                   Constructors and Destructors                      //
+/////////////////////////////////////////////////////////////////////////
+
+// Statistics constructor
+inline Hash_table_stats::Hash_table_stats():
+capacity( 0 ), live( 0 ), erased( 0 ), empty( 0 ), pending( 0 ),
+average_hit_probe( 0.0 ), average_miss_probe( 0.0 ),
+max_hit_probe( 0 ), max_miss_probe( 0 ),
+inserts( 0 ), erases( 0 ), rehashes( 0 ) {
+	// empty constructor
+}
+
+// Constructor
+template <typename Slot, typename Key, typename Key_of, typename Hash>
+Quadratic_hash_engine<Slot, Key, Key_of, Hash>::Quadratic_hash_engine( int m, double lf, Hash const &hf ):
+count( 0 ), countErased( 0 ),
+power( (m >= 0) ? m : 5),                       // The power of 2 will simply be the argument if positive, but 5 if negative
+array_size( 1 << power ),
+mask( array_size - 1 ),
+array( nullptr ),
+tags( nullptr ),
+hash_function( hf ),
+epoch( 0 ),
+occupancy( nullptr ),
+occupancy_epochs( nullptr ),
+max_load( lf ),
+old_array_size( 0 ),
+old_count( 0 ),
+migrate_bin( 0 ),
+old_array( nullptr ),
+old_tags( nullptr )
+#ifdef QUADRATIC_HASH_STATS
+, inserts( 0 ), erases( 0 ), rehashes( 0 )
+#endif
+{
+    // The maximum load factor must leave at least one UNOCCUPIED bin so that probing terminates
+    if ( lf <= 0.0 || lf >= 1.0 ) {
+        throw illegal_argument();
+    }
+
+    array = allocate_slots( array_size );
+    tags = allocate_tags( array_size );
+    allocate_occupancy( array_size, occupancy, occupancy_epochs );
+}
+
+// Destructor
+template <typename Slot, typename Key, typename Key_of, typename Hash>
+Quadratic_hash_engine<Slot, Key, Key_of, Hash>::~Quadratic_hash_engine() {
+    release( array, tags, array_size );
+    release( old_array, old_tags, old_array_size );
+    delete [] occupancy;
+    delete [] occupancy_epochs;
+}
+
+/////////////////////////////////////////////////////////////////////////
+//                     Public Member Functions                         //
+/////////////////////////////////////////////////////////////////////////
+
+// Return the number of elements stored in the hash table
+template <typename Slot, typename Key, typename Key_of, typename Hash>
+int Quadratic_hash_engine<Slot, Key, Key_of, Hash>::size() const {
+    return count;
+}
+
+// Return the number of bins in the hash table
+template <typename Slot, typename Key, typename Key_of, typename Hash>
+int Quadratic_hash_engine<Slot, Key, Key_of, Hash>::capacity() const {
+    return array_size;
+}
+
+// Return the load factor of the hash table
+// Elements still waiting to be migrated from the previous arrays are counted as they will end up in the current ones
+template <typename Slot, typename Key, typename Key_of, typename Hash>
+double Quadratic_hash_engine<Slot, Key, Key_of, Hash>::load_factor() const {
+    return static_cast<double>(count + countErased) / static_cast<double>(array_size);
+}
+
+// Return the load factor at which the hash table grows or compacts its ERASED bins
+template <typename Slot, typename Key, typename Key_of, typename Hash>
+double Quadratic_hash_engine<Slot, Key, Key_of, Hash>::max_load_factor() const {
+    return max_load;
+}
+
+// Return true if the hash table is empty, false otherwise
+template <typename Slot, typename Key, typename Key_of, typename Hash>
+bool Quadratic_hash_engine<Slot, Key, Key_of, Hash>::empty() const {
+    return size() == 0;
+}
+
+// Return an iterator to the first object in the hash table
+// Any rehash in progress is completed first, so that every object is in the current arrays
+template <typename Slot, typename Key, typename Key_of, typename Hash>
+typename Quadratic_hash_engine<Slot, Key, Key_of, Hash>::const_iterator
+Quadratic_hash_engine<Slot, Key, Key_of, Hash>::begin() const {
+    finish_rehash();
+
+    return const_iterator( this, next_occupied( 0 ) );
+}
+
+// Return an iterator past the last bin of the hash table
+template <typename Slot, typename Key, typename Key_of, typename Hash>
+typename Quadratic_hash_engine<Slot, Key, Key_of, Hash>::const_iterator
+Quadratic_hash_engine<Slot, Key, Key_of, Hash>::end() const {
+    return const_iterator( this, array_size );
+}
+
+// Return the occupancy and probe length statistics of the hash table
+// This walks every bin of the current arrays and replays the probes, so it is meant
+// for diagnostics and tuning rather than for hot paths
+template <typename Slot, typename Key, typename Key_of, typename Hash>
+Hash_table_stats Quadratic_hash_engine<Slot, Key, Key_of, Hash>::stats() const {
+    Hash_table_stats result;
+    long hit_total = 0;
+    long miss_total = 0;
+
+    result.capacity = array_size;
+    result.pending = rehashing() ? old_count : 0;
+
+    for ( int i = 0; i < array_size; ++i ) {
+        if ( state_of( tags[i] ) == OCCUPIED ) {
+            result.live++;
+
+            // Replay the probe for the object in this bin
+            int length = probe_length( static_cast<int>( hash( Key_of::key( array[i] ) ) & mask ), i );
+
+            if ( length >= static_cast<int>( result.hit_probe_lengths.size() ) )
+                result.hit_probe_lengths.resize( length + 1, 0 );
+
+            result.hit_probe_lengths[length]++;
+            hit_total += length;
+
+            if ( length > result.max_hit_probe )
+                result.max_hit_probe = length;
+        } else if ( state_of( tags[i] ) == ERASED ) {
+            result.erased++;
+        } else {
+            result.empty++;
+        }
+
+        // Replay a probe for an absent key whose home bin is i, which ends at the first UNOCCUPIED bin
+        int length = probe_length( i, -1 );
+
+        if ( length >= static_cast<int>( result.miss_probe_lengths.size() ) )
+            result.miss_probe_lengths.resize( length + 1, 0 );
+
+        result.miss_probe_lengths[length]++;
+        miss_total += length;
+
+        if ( length > result.max_miss_probe )
+            result.max_miss_probe = length;
+    }
+
+    result.average_hit_probe = (result.live > 0) ? static_cast<double>( hit_total ) / result.live : 0.0;
+    result.average_miss_probe = static_cast<double>( miss_total ) / array_size;
+
+#ifdef QUADRATIC_HASH_STATS
+    result.inserts = inserts;
+    result.erases = erases;
+    result.rehashes = rehashes;
+#endif
+
+    return result;
+}
+
+// Set the load factor at which the hash table grows or compacts its ERASED bins
+// The new limit takes effect on the next insertion
+template <typename Slot, typename Key, typename Key_of, typename Hash>
+void Quadratic_hash_engine<Slot, Key, Key_of, Hash>::max_load_factor( double lf ) {
+    if ( lf <= 0.0 || lf >= 1.0 )
+        throw illegal_argument();
+
+    max_load = lf;
+}
+
+// Clear all elements in the hash table by starting a new epoch, in which every bin reads as UNOCCUPIED
+// The bins are only visited if the slots need destroying, or once every EPOCH_LIMIT calls
+// when the epoch wraps and the stale tags must be reset before they can match again
+// Any rehash in progress is abandoned along with the previous arrays
+template <typename Slot, typename Key, typename Key_of, typename Hash>
+void Quadratic_hash_engine<Slot, Key, Key_of, Hash>::clear() {
+    if ( !std::is_trivially_destructible<Slot>::value ) {
+        for ( int i = 0; i < array_size; i++ ) {
+            if ( state_of( tags[i] ) == OCCUPIED )
+                array[i].~Slot();
+        }
+    }
+
+    release( old_array, old_tags, old_array_size );
+
+    if ( ++epoch == EPOCH_LIMIT ) {
+        for ( int i = 0; i < array_size; i++ ) {
+            tags[i] = 0;
+        }
+
+        for ( int w = 0; w < (array_size + 63) / 64; w++ ) {
+            occupancy[w] = 0;
+            occupancy_epochs[w] = 0;
+        }
+
+        epoch = 0;
+    }
+
+    count = 0;
+    countErased = 0;
+    old_array = nullptr;
+    old_tags = nullptr;
+    old_array_size = 0;
+    old_count = 0;
+    migrate_bin = 0;
+}
+
+/////////////////////////////////////////////////////////////////////////
+//                     Protected member functions                      //
+/////////////////////////////////////////////////////////////////////////
+
+// Return the state recorded in a bin tag, or UNOCCUPIED if it was written in an earlier epoch
+template <typename Slot, typename Key, typename Key_of, typename Hash>
+bin_state_t Quadratic_hash_engine<Slot, Key, Key_of, Hash>::state_of( std::uint32_t tag ) const {
+    return ( (tag >> 2) == epoch ) ? static_cast<bin_state_t>( tag & 3 ) : UNOCCUPIED;
+}
+
+// Return the tag recording a bin state in the current epoch
+template <typename Slot, typename Key, typename Key_of, typename Hash>
+std::uint32_t Quadratic_hash_engine<Slot, Key, Key_of, Hash>::tag_of( bin_state_t bin_state ) const {
+    return (epoch << 2) | static_cast<std::uint32_t>( bin_state );
+}
+
+// Return the state of bin n of the current arrays
+template <typename Slot, typename Key, typename Key_of, typename Hash>
+bin_state_t Quadratic_hash_engine<Slot, Key, Key_of, Hash>::state( int n ) const {
+    return state_of( tags[n] );
+}
+
+// Return word w of the occupancy bitmap, or 0 if it was written in an earlier epoch
+template <typename Slot, typename Key, typename Key_of, typename Hash>
+std::uint64_t Quadratic_hash_engine<Slot, Key, Key_of, Hash>::occupancy_word( int w ) const {
+    return (occupancy_epochs[w] == epoch) ? occupancy[w] : 0;
+}
+
+// Set or clear the occupancy bit of bin n of the current arrays
+template <typename Slot, typename Key, typename Key_of, typename Hash>
+void Quadratic_hash_engine<Slot, Key, Key_of, Hash>::mark_occupied( int n, bool is_occupied ) const {
+    int w = n >> 6;
+
+    // A word from an earlier epoch is stale, so start it again from 0
+    if ( occupancy_epochs[w] != epoch ) {
+        occupancy[w] = 0;
+        occupancy_epochs[w] = epoch;
+    }
+
+    if ( is_occupied ) {
+        occupancy[w] |= std::uint64_t( 1 ) << (n & 63);
+    } else {
+        occupancy[w] &= ~(std::uint64_t( 1 ) << (n & 63));
+    }
+}
+
+// Return the first OCCUPIED bin of the current arrays at or after bin n, or array_size if there is none
+template <typename Slot, typename Key, typename Key_of, typename Hash>
+int Quadratic_hash_engine<Slot, Key, Key_of, Hash>::next_occupied( int n ) const {
+    if ( n >= array_size )
+        return array_size;
+
+    int words = (array_size + 63) / 64;
+    int w = n >> 6;
+    std::uint64_t bits = occupancy_word( w ) & (~std::uint64_t( 0 ) << (n & 63));
+
+    while ( bits == 0 ) {
+        if ( ++w == words )
+            return array_size;
+
+        bits = occupancy_word( w );
+    }
+
+    return (w << 6) + lowest_bit( bits );
+}
+
+// Hash function that returns the full hash value of a key
+// Callers reduce it to a bin with a bit mask, which is why the array sizes are powers of 2
+template <typename Slot, typename Key, typename Key_of, typename Hash>
+std::uint64_t Quadratic_hash_engine<Slot, Key, Key_of, Hash>::hash( Key const &key ) const {
+    return static_cast<std::uint64_t>( hash_function( key ) );
+}
+
+// Return the number of bins visited by a probe of the current arrays that starts at bin home
+// and ends at bin target, or at the first UNOCCUPIED bin if target is -1
+template <typename Slot, typename Key, typename Key_of, typename Hash>
+int Quadratic_hash_engine<Slot, Key, Key_of, Hash>::probe_length( int home, int target ) const {
+    int bin = home;
+
+    for ( int k = 0; k < array_size; k++ ) {
+        bin = (bin + k) & mask;
+
+        if ( bin == target || (target < 0 && state_of( tags[bin] ) == UNOCCUPIED) )
+            return k + 1;
+    }
+
+    return array_size;
+}
+
+// Probe one pair of arrays for the argument key and return its bin, or -1 if it is not there
+// The probe ends at the first UNOCCUPIED bin; if free_bin is not nullptr it is set to the
+// first ERASED bin passed on the way, or else to that UNOCCUPIED bin, which is where the
+// key belongs if it is inserted
+template <typename Slot, typename Key, typename Key_of, typename Hash>
+int Quadratic_hash_engine<Slot, Key, Key_of, Hash>::find_bin( Slot const *slots, std::uint32_t const *bin_tags, int bins,
+                                                              Key const &key, std::uint64_t hash_value, int *free_bin ) const {
+    int bin_mask = bins - 1;
+    int bin = static_cast<int>( hash_value & bin_mask );
+    int first_erased = -1;
+
+    for ( int k = 0; k < bins; k++ ) {
+        // Quadratic probing
+        bin = (bin + k) & bin_mask;
+
+        // If an UNOCCUPIED bin is reached before finding the key, then the key can't be in these arrays
+        if ( state_of( bin_tags[bin] ) == UNOCCUPIED ) {
+            if ( free_bin != nullptr )
+                *free_bin = (first_erased >= 0) ? first_erased : bin;
+
+            return -1;
+        }
+
+        // Only return the bin if it is OCCUPIED AND its key is equal to the argument key
+        if ( state_of( bin_tags[bin] ) == OCCUPIED ) {
+            if ( Key_of::key( slots[bin] ) == key )
+                return bin;
+        } else if ( first_erased < 0 ) {
+            first_erased = bin;
+        }
+    }
+
+    // Every bin was visited without reaching an UNOCCUPIED one
+    if ( free_bin != nullptr )
+        *free_bin = first_erased;
+
+    return -1;
+}
+
+// Return the slot holding the argument key, or nullptr if the key is not in the hash table
+// This does not migrate any bins, so pointers to slots stay valid across lookups
+template <typename Slot, typename Key, typename Key_of, typename Hash>
+Slot *Quadratic_hash_engine<Slot, Key, Key_of, Hash>::find_slot( Key const &key ) const {
+    return find_hashed( key, hash( key ) );
+}
+
+// Same as find_slot() for a key whose hash value has already been computed
+// The same hash value is reduced to a bin of either array with a bit mask
+template <typename Slot, typename Key, typename Key_of, typename Hash>
+Slot *Quadratic_hash_engine<Slot, Key, Key_of, Hash>::find_hashed( Key const &key, std::uint64_t hash_value ) const {
+    int bin = find_bin( array, tags, array_size, key, hash_value, nullptr );
+
+    if ( bin >= 0 )
+        return array + bin;
+
+    if ( !rehashing() )
+        return nullptr;
+
+    // The key may not have been migrated yet, so repeat the search in the previous arrays
+    bin = find_bin( old_array, old_tags, old_array_size, key, hash_value, nullptr );
+
+    return (bin >= 0) ? old_array + bin : nullptr;
+}
+
+// Construct a slot from the arguments unless the key is already in the hash table
+// Returns the slot holding the key and whether it was inserted
+//
+// A single probe of the current arrays either finds the key or remembers the bin it
+// belongs in, reusing the first ERASED bin on the way, so the key is never probed for twice
+// Reusing an ERASED bin does not change the load factor and so never starts a rehash
+//
+// The arguments are consumed before any bins are migrated, so they may refer to other slots
+template <typename Slot, typename Key, typename Key_of, typename Hash>
+template <typename... Args>
+std::pair<Slot *, bool> Quadratic_hash_engine<Slot, Key, Key_of, Hash>::emplace_slot( Key const &key, Args &&... args ) {
+    return emplace_hashed( key, hash( key ), std::forward<Args>( args )... );
+}
+
+// Same as emplace_slot() for a key whose hash value has already been computed
+template <typename Slot, typename Key, typename Key_of, typename Hash>
+template <typename... Args>
+std::pair<Slot *, bool> Quadratic_hash_engine<Slot, Key, Key_of, Hash>::emplace_hashed( Key const &key, std::uint64_t hash_value, Args &&... args ) {
+    int free_bin = -1;
+    int bin = find_bin( array, tags, array_size, key, hash_value, &free_bin );
+
+    // Do nothing if the key is already in the hash table
+    // Nothing is migrated either, as that could move the slot being returned
+    if ( bin >= 0 ) {
+        return std::make_pair( array + bin, false );
+    }
+
+    if ( rehashing() ) {
+        int old_bin = find_bin( old_array, old_tags, old_array_size, key, hash_value, nullptr );
+
+        // If the key has not been migrated yet, move it into the bin it belongs in now,
+        // so that the returned slot is always in the current arrays
+        if ( old_bin >= 0 ) {
+            Slot *slot = construct_at( free_bin, std::move( old_array[old_bin] ) );
+            old_array[old_bin].~Slot();
+            old_tags[old_bin] = tag_of( ERASED );
+            old_count--;
+
+            return std::make_pair( slot, false );
+        }
+    }
+
+    Slot *slot;
+
+    // Start a new rehash when filling an UNOCCUPIED bin would push the table past its maximum load factor
+    if ( state_of( tags[free_bin] ) == UNOCCUPIED && count + countErased + 1 > max_load * array_size ) {
+        if ( rehashing() ) {
+            // The previous rehash has not completed yet, so finish it first
+            // The slot is built beforehand as finishing moves every remaining slot
+            Slot obj( std::forward<Args>( args )... );
+            finish_rehash();
+            start_rehash();
+            slot = place( hash_value, std::move( obj ) );
+            count++;
+            QUADRATIC_HASH_COUNT( inserts );
+
+            return std::make_pair( slot, true );
+        }
+
+        start_rehash();
+        slot = place( hash_value, std::forward<Args>( args )... );
+    } else {
+        slot = construct_at( free_bin, std::forward<Args>( args )... );
+    }
+
+    count++;
+    QUADRATIC_HASH_COUNT( inserts );
+
+    // Pay for a slice of the rehash only once the new slot is in place
+    // The new slot is in the current arrays, which migration never moves
+    migrate( MIGRATE_STEP );
+
+    return std::make_pair( slot, true );
+}
+
+// Start loading the home bins of a hash value into the cache
+// The batched operations prefetch a whole batch of keys before probing for any of them,
+// so the cache misses for the different keys overlap instead of happening one after another
+template <typename Slot, typename Key, typename Key_of, typename Hash>
+void Quadratic_hash_engine<Slot, Key, Key_of, Hash>::prefetch_hashed( std::uint64_t hash_value ) const {
+#if defined(__GNUC__)
+    int bin = static_cast<int>( hash_value & mask );
+    __builtin_prefetch( tags + bin );
+    __builtin_prefetch( array + bin );
+
+    if ( rehashing() ) {
+        int old_bin = static_cast<int>( hash_value & (old_array_size - 1) );
+        __builtin_prefetch( old_tags + old_bin );
+        __builtin_prefetch( old_array + old_bin );
+    }
+#else
+    (void) hash_value;
+#endif
+}
+
+// Erases the slot holding the argument key and returns true on success, false otherwise
+template <typename Slot, typename Key, typename Key_of, typename Hash>
+bool Quadratic_hash_engine<Slot, Key, Key_of, Hash>::erase_slot( Key const &key ) {
+    // Pay for a slice of any rehash in progress
+    migrate( MIGRATE_STEP );
+
+    // Get the hash value for the key that is to be erased
+    std::uint64_t hash_value = hash( key );
+    int bin = find_bin( array, tags, array_size, key, hash_value, nullptr );
+
+    // If the key is in the current arrays, then destroy the slot and set the bin to ERASED
+    if ( bin >= 0 ) {
+        array[bin].~Slot();
+        tags[bin] = tag_of( ERASED );
+        mark_occupied( bin, false );
+        count--;
+        countErased++;
+        QUADRATIC_HASH_COUNT( erases );
+        return true;
+    }
+
+    if ( !rehashing() )
+        return false;
+
+    // The key may still be waiting in the previous arrays
+    // Bins erased there are discarded with the arrays, so they are not counted in countErased
+    bin = find_bin( old_array, old_tags, old_array_size, key, hash_value, nullptr );
+
+    if ( bin < 0 )
+        return false;
+
+    old_array[bin].~Slot();
+    old_tags[bin] = tag_of( ERASED );
+    count--;
+    old_count--;
+    QUADRATIC_HASH_COUNT( erases );
+    return true;
+}
+
+// Return true if slots are still waiting to be migrated from the previous arrays
+template <typename Slot, typename Key, typename Key_of, typename Hash>
+bool Quadratic_hash_engine<Slot, Key, Key_of, Hash>::rehashing() const {
+    return old_array != nullptr;
+}
+
+// Swap in fresh arrays and start migrating the current contents into them
+// The arrays double in size if the live slots alone would fill more than half of the
+// maximum load, otherwise they keep their size and the rehash only compacts away ERASED bins
+// Like reserve_empty(), this stops at 2^30 bins: growing past that throws overflow before
+// anything is changed
+template <typename Slot, typename Key, typename Key_of, typename Hash>
+void Quadratic_hash_engine<Slot, Key, Key_of, Hash>::start_rehash() {
+    int new_power = ( 2*(count + 1) > max_load * array_size ) ? power + 1 : power;
+
+    if ( new_power > 30 )
+        throw overflow();
+
+    Slot *new_array = allocate_slots( 1 << new_power );
+    std::uint32_t *new_tags = allocate_tags( 1 << new_power );
+
+    // Only the current arrays are iterated over, so the previous ones need no bitmap
+    delete [] occupancy;
+    delete [] occupancy_epochs;
+    allocate_occupancy( 1 << new_power, occupancy, occupancy_epochs );
+
+    old_array = array;
+    old_tags = tags;
+    old_array_size = array_size;
+    old_count = count;
+    migrate_bin = 0;
+
+    power = new_power;
+    array_size = 1 << power;
+    mask = array_size - 1;
+    array = new_array;
+    tags = new_tags;
+    countErased = 0;
+    QUADRATIC_HASH_COUNT( rehashes );
+}
+
+// Move the next n bins of the previous arrays into the current arrays
+template <typename Slot, typename Key, typename Key_of, typename Hash>
+void Quadratic_hash_engine<Slot, Key, Key_of, Hash>::migrate( int n ) const {
+    if ( !rehashing() )
+        return;
+
+    for ( ; n > 0 && migrate_bin < old_array_size; --n, ++migrate_bin ) {
+        // Migrated bins are marked ERASED rather than UNOCCUPIED so that probe sequences
+        // through them still reach the slots that have not been migrated yet
+        if ( state_of( old_tags[migrate_bin] ) == OCCUPIED ) {
+            Slot &obj = old_array[migrate_bin];
+
+            place( hash( Key_of::key( obj ) ), std::move( obj ) );
+            obj.~Slot();
+            old_tags[migrate_bin] = tag_of( ERASED );
+            old_count--;
+        }
+    }
+
+    // Release the previous arrays once every bin has been migrated
+    if ( migrate_bin == old_array_size || old_count == 0 ) {
+        release( old_array, old_tags, old_array_size );
+        old_array = nullptr;
+        old_tags = nullptr;
+        old_array_size = 0;
+        migrate_bin = 0;
+    }
+}
+
+// Complete any rehash in progress in one step
+template <typename Slot, typename Key, typename Key_of, typename Hash>
+void Quadratic_hash_engine<Slot, Key, Key_of, Hash>::finish_rehash() const {
+    migrate( old_array_size );
+}
+
+// Construct a slot whose key is known not to be in the hash table in the first
+// available bin of its probe sequence in the current arrays
+template <typename Slot, typename Key, typename Key_of, typename Hash>
+template <typename... Args>
+Slot *Quadratic_hash_engine<Slot, Key, Key_of, Hash>::place( std::uint64_t hash_value, Args &&... args ) const {
+    int bin = static_cast<int>( hash_value & mask );
+
+    for ( int k = 0; k < array_size; k++ ) {
+        // Quadratic probing
+        bin = (bin + k) & mask;
+
+        // Look for an unoccupied bin and construct the slot in that bin
+        if ( state_of( tags[bin] ) != OCCUPIED ) {
+            return construct_at( bin, std::forward<Args>( args )... );
+        }
+    }
+
+    // Not reached: the maximum load factor always leaves a free bin
+    return nullptr;
+}
+
+// Construct a slot in a bin of the current arrays that is not OCCUPIED
+template <typename Slot, typename Key, typename Key_of, typename Hash>
+template <typename... Args>
+Slot *Quadratic_hash_engine<Slot, Key, Key_of, Hash>::construct_at( int bin, Args &&... args ) const {
+    new ( array + bin ) Slot( std::forward<Args>( args )... );
+
+    // Decrement the countErased variable if the bin was previously erased
+    if ( state_of( tags[bin] ) == ERASED )
+        countErased--;
+
+    tags[bin] = tag_of( OCCUPIED );
+    mark_occupied( bin, true );
+
+    return array + bin;
+}
+
+// Replace the arrays of a newly constructed, empty hash table with arrays large enough
+// to hold n objects without reaching the maximum load factor
+template <typename Slot, typename Key, typename Key_of, typename Hash>
+void Quadratic_hash_engine<Slot, Key, Key_of, Hash>::reserve_empty( std::size_t n ) {
+    int new_power = power;
+
+    while ( static_cast<double>( n + 1 ) > max_load * static_cast<double>( std::size_t( 1 ) << new_power ) ) {
+        if ( ++new_power > 30 )
+            throw overflow();
+    }
+
+    if ( new_power == power )
+        return;
+
+    release( array, tags, array_size );
+    delete [] occupancy;
+    delete [] occupancy_epochs;
+
+    power = new_power;
+    array_size = 1 << power;
+    mask = array_size - 1;
+    array = allocate_slots( array_size );
+    tags = allocate_tags( array_size );
+    allocate_occupancy( array_size, occupancy, occupancy_epochs );
+}
+
+// Insert the objects in the range [first, last) into a newly constructed, empty hash table
+template <typename Slot, typename Key, typename Key_of, typename Hash>
+template <typename Iterator>
+void Quadratic_hash_engine<Slot, Key, Key_of, Hash>::build( Iterator first, Iterator last ) {
+    build( first, last, typename std::iterator_traits<Iterator>::iterator_category() );
+}
+
+// A single-pass range cannot be counted in advance, so its objects are inserted one at a time
+template <typename Slot, typename Key, typename Key_of, typename Hash>
+template <typename Iterator>
+void Quadratic_hash_engine<Slot, Key, Key_of, Hash>::build( Iterator first, Iterator last, std::input_iterator_tag ) {
+    for ( ; first != last; ++first ) {
+        Slot const &obj = *first;
+
+        emplace_slot( Key_of::key( obj ), obj );
+    }
+}
+
+// A multi-pass range is counted first, so that the arrays are sized once
+template <typename Slot, typename Key, typename Key_of, typename Hash>
+template <typename Iterator>
+void Quadratic_hash_engine<Slot, Key, Key_of, Hash>::build( Iterator first, Iterator last, std::forward_iterator_tag ) {
+    reserve_empty( static_cast<std::size_t>( std::distance( first, last ) ) );
+    build( first, last, std::input_iterator_tag() );
+}
+
+// A random-access range is sized once and, if it is large, inserted by several threads
+//
+// The bins are split into one region per thread, aligned to whole words of the occupancy
+// bitmap, and the objects are grouped by the region of their home bin with a counting sort
+// Each thread then inserts the objects of its own region, touching no bin outside it, and
+// defers any object whose probe sequence leaves the region
+// The deferred objects, usually a small fraction near the region boundaries, are inserted
+// afterwards by the calling thread
+//
+// Every bin before an object in its probe sequence was OCCUPIED when it was placed, just as
+// with insert(), and a duplicate follows the same probe sequence as the object it repeats,
+// so it is either found in the region or deferred along with it
+template <typename Slot, typename Key, typename Key_of, typename Hash>
+template <typename Iterator>
+void Quadratic_hash_engine<Slot, Key, Key_of, Hash>::build( Iterator first, Iterator last, std::random_access_iterator_tag ) {
+    std::size_t n = static_cast<std::size_t>( last - first );
+    int threads = ( n >= PARALLEL_BUILD_MIN ) ? static_cast<int>( std::thread::hardware_concurrency() ) : 1;
+    int region_power = 0;
+
+    reserve_empty( n );
+
+    while ( (2 << region_power) <= threads && (array_size >> (region_power + 1)) >= PARALLEL_REGION_MIN ) {
+        region_power++;
+    }
+
+    // Too small to be worth splitting: insert in batches, prefetching each batch as insert_batch() does
+    if ( region_power == 0 ) {
+        std::uint64_t hash_values[BATCH_SIZE];
+
+        for ( std::size_t start = 0; start < n; start += BATCH_SIZE ) {
+            int batch = static_cast<int>( (n - start < BATCH_SIZE) ? n - start : BATCH_SIZE );
+
+            for ( int i = 0; i < batch; ++i ) {
+                hash_values[i] = hash( Key_of::key( first[start + i] ) );
+                prefetch_hashed( hash_values[i] );
+            }
+
+            for ( int i = 0; i < batch; ++i ) {
+                emplace_hashed( Key_of::key( first[start + i] ), hash_values[i], first[start + i] );
+            }
+        }
+
+        return;
+    }
+
+    int regions = 1 << region_power;
+    int region_shift = power - region_power;
+    std::size_t chunk = (n + regions - 1) / regions;
+
+    std::vector<std::uint64_t> hash_values( n );
+    std::vector<std::size_t> order( n );
+    std::vector<std::size_t> region_start( regions + 1 );
+    std::vector< std::vector<std::size_t> > deferred( regions );
+    std::vector<int> inserted( regions );
+
+    // offsets[t*regions + r] is first the number of objects in chunk t with a home bin in region r,
+    // then the position in order of the next of them
+    std::vector<std::size_t> offsets( regions * regions, 0 );
+
+    // Hash each chunk of the objects and count them by region
+    run_in_parallel( regions, [&]( int t ) {
+        std::size_t end = (t + 1) * chunk < n ? (t + 1) * chunk : n;
+
+        for ( std::size_t i = t * chunk; i < end; ++i ) {
+            hash_values[i] = hash( Key_of::key( first[i] ) );
+            offsets[t * regions + static_cast<int>( (hash_values[i] & mask) >> region_shift )]++;
+        }
+    } );
+
+    std::size_t position = 0;
+
+    for ( int r = 0; r < regions; ++r ) {
+        region_start[r] = position;
+
+        for ( int t = 0; t < regions; ++t ) {
+            std::size_t objects = offsets[t * regions + r];
+            offsets[t * regions + r] = position;
+            position += objects;
+        }
+    }
+
+    region_start[regions] = n;
+
+    // Group the objects by region, keeping their order within each chunk
+    run_in_parallel( regions, [&]( int t ) {
+        std::size_t end = (t + 1) * chunk < n ? (t + 1) * chunk : n;
+
+        for ( std::size_t i = t * chunk; i < end; ++i ) {
+            order[offsets[t * regions + static_cast<int>( (hash_values[i] & mask) >> region_shift )]++] = i;
+        }
+    } );
+
+    // Fill each region from its own thread
+    run_in_parallel( regions, [&]( int r ) {
+        inserted[r] = build_region( first, hash_values.data(), order.data(), region_start[r], region_start[r + 1],
+                                    r << region_shift, (r + 1) << region_shift, deferred[r] );
+    } );
+
+    for ( int r = 0; r < regions; ++r ) {
+        count += inserted[r];
+#ifdef QUADRATIC_HASH_STATS
+        inserts += inserted[r];
+#endif
+    }
+
+    for ( int r = 0; r < regions; ++r ) {
+        for ( std::size_t j = 0; j < deferred[r].size(); ++j ) {
+            std::size_t i = deferred[r][j];
+
+            emplace_hashed( Key_of::key( first[i] ), hash_values[i], first[i] );
+        }
+    }
+}
+
+// Insert the objects first[order[j]] for begin <= j < end whose probe sequences stay within bins [lo, hi)
+// The indices of the others are appended to deferred
+// Returns the number of objects inserted; count is not changed, as other threads are doing the same
+template <typename Slot, typename Key, typename Key_of, typename Hash>
+template <typename Iterator>
+int Quadratic_hash_engine<Slot, Key, Key_of, Hash>::build_region( Iterator first, std::uint64_t const *hash_values,
+                                                                  std::size_t const *order, std::size_t begin, std::size_t end,
+                                                                  int lo, int hi, std::vector<std::size_t> &deferred ) {
+    int inserted = 0;
+
+    for ( std::size_t j = begin; j < end; ++j ) {
+        std::size_t i = order[j];
+
+        // Converted once, and kept for the whole probe, if the range holds some other type
+        Slot const &obj = first[i];
+        Key const &key = Key_of::key( obj );
+        int bin = static_cast<int>( hash_values[i] & mask );
+
+        for ( int k = 0; k < array_size; k++ ) {
+            // Quadratic probing
+            bin = (bin + k) & mask;
+
+            if ( bin < lo || bin >= hi ) {
+                deferred.push_back( i );
+                break;
+            }
+
+            if ( state_of( tags[bin] ) == UNOCCUPIED ) {
+                new ( array + bin ) Slot( obj );
+                tags[bin] = tag_of( OCCUPIED );
+                mark_occupied( bin, true );
+                inserted++;
+                break;
+            }
+
+            // A repeated object is dropped
+            if ( Key_of::key( array[bin] ) == key )
+                break;
+        }
+    }
+
+    return inserted;
+}
+
+// Call f( 0 ), ..., f( n - 1 ), each on its own thread, and wait for all of them
+// f( 0 ) runs on the calling thread
+template <typename Slot, typename Key, typename Key_of, typename Hash>
+template <typename Function>
+void Quadratic_hash_engine<Slot, Key, Key_of, Hash>::run_in_parallel( int n, Function f ) {
+    std::vector<std::thread> workers;
+
+    for ( int i = 1; i < n; ++i ) {
+        workers.emplace_back( f, i );
+    }
+
+    f( 0 );
+
+    for ( std::size_t i = 0; i < workers.size(); ++i ) {
+        workers[i].join();
+    }
+}
+
+// Allocate uninitialized storage for n slots
+template <typename Slot, typename Key, typename Key_of, typename Hash>
+Slot *Quadratic_hash_engine<Slot, Key, Key_of, Hash>::allocate_slots( int n ) {
+    return static_cast<Slot *>( ::operator new( n * sizeof( Slot ) ) );
+}
+
+// Allocate n bin tags, all 0
+// A zero tag reads as UNOCCUPIED in every epoch: epoch 0 stores UNOCCUPIED in its state bits
+template <typename Slot, typename Key, typename Key_of, typename Hash>
+std::uint32_t *Quadratic_hash_engine<Slot, Key, Key_of, Hash>::allocate_tags( int n ) {
+    return new std::uint32_t[n]();
+}
+
+// Allocate an occupancy bitmap for n bins with every bit clear
+template <typename Slot, typename Key, typename Key_of, typename Hash>
+void Quadratic_hash_engine<Slot, Key, Key_of, Hash>::allocate_occupancy( int n, std::uint64_t *&words, std::uint32_t *&word_epochs ) {
+    words = new std::uint64_t[(n + 63) / 64]();
+    word_epochs = new std::uint32_t[(n + 63) / 64]();
+}
+
+// Destroy the slots in all OCCUPIED bins and free both arrays
+template <typename Slot, typename Key, typename Key_of, typename Hash>
+void Quadratic_hash_engine<Slot, Key, Key_of, Hash>::release( Slot *slots, std::uint32_t *slot_tags, int n ) const {
+    if ( slots == nullptr )
+        return;
+
+    if ( !std::is_trivially_destructible<Slot>::value ) {
+        for ( int i = 0; i < n; ++i ) {
+            if ( state_of( slot_tags[i] ) == OCCUPIED )
+                slots[i].~Slot();
+        }
+    }
+
+    ::operator delete( slots );
+    delete [] slot_tags;
+}
+
+#endif
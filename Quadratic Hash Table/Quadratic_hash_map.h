@@ -0,0 +1,203 @@
+#ifndef QUADRATIC_HASH_MAP_H
+#define QUADRATIC_HASH_MAP_H
+
+#include "Quadratic_hash_engine.h"
+
+// A key and its value as stored in one bin of a Quadratic_hash_map
+template <typename Key, typename Value>
+class Map_entry {
+	public:
+		template <typename K, typename... Args>
+		Map_entry( K &&, Args &&... );
+
+		Key   entry_key;
+		Value entry_value;
+
+		// Key_of for the engine
+		static Key const &key( Map_entry const &entry ) {
+		    return entry.entry_key;
+		}
+};
+
+// A map from keys to values stored with quadratic probing on the same engine as Quadratic_hash_table
+// A single probe sequence both finds a key and reaches its value
+//
+// Pointers returned by find(), try_emplace() and the other inserting functions stay valid
+// across lookups, but any insertion or erase may migrate entries while the table rehashes
+template <typename Key, typename Value, typename Hash = Mixing_hash<Key> >
+class Quadratic_hash_map : public Quadratic_hash_engine<Map_entry<Key, Value>, Key, Map_entry<Key, Value>, Hash> {
+	private:
+		typedef Map_entry<Key, Value> Entry;
+		typedef Quadratic_hash_engine<Entry, Key, Entry, Hash> Engine;
+
+	public:
+		Quadratic_hash_map( int = 5, double = 0.75, Hash const & = Hash() );
+
+		// Accessors
+
+		bool member( Key const & ) const;
+		Value *find( Key const & );
+		Value const *find( Key const & ) const;
+
+		// Mutators
+
+		Value &operator[]( Key const & );
+		Value &operator[]( Key && );
+
+		template <typename... Args>
+		std::pair<Value *, bool> try_emplace( Key const &, Args &&... );
+		template <typename... Args>
+		std::pair<Value *, bool> try_emplace( Key &&, Args &&... );
+		template <typename... Args>
+		std::pair<Value *, bool> emplace( Key const &, Args &&... );
+
+		template <typename V>
+		std::pair<Value *, bool> insert_or_assign( Key const &, V && );
+		template <typename V>
+		std::pair<Value *, bool> insert_or_assign( Key &&, V && );
+
+		bool erase( Key const & );
+
+	// Friends
+
+	template <typename K, typename V, typename H>
+	friend std::ostream &operator<<( std::ostream &, Quadratic_hash_map<K, V, H> const & );
+};
+
+/////////////////////////////////////////////////////////////////////////
+//                   Constructors and Destructors                      //
+/////////////////////////////////////////////////////////////////////////
+
+// Entry constructor
+// The key is built from the first argument and the value from all remaining arguments
+template <typename Key, typename Value>
+template <typename K, typename... Args>
+Map_entry<Key, Value>::Map_entry( K &&k, Args &&... args ):
+entry_key( std::forward<K>( k ) ),
+entry_value( std::forward<Args>( args )... ) {
+	// empty constructor
+}
+
+// Constructor
+// The power of 2 will simply be the first argument if positive, but 5 if negative
+template <typename Key, typename Value, typename Hash>
+Quadratic_hash_map<Key, Value, Hash>::Quadratic_hash_map( int m, double lf, Hash const &hf ):
+Engine( m, lf, hf ) {
+	// empty constructor
+}
+
+/////////////////////////////////////////////////////////////////////////
+//                     Public Member Functions                         //
+/////////////////////////////////////////////////////////////////////////
+
+//ACCESSORS
+
+// Return true if the argument key is in the map
+template <typename Key, typename Value, typename Hash>
+bool Quadratic_hash_map<Key, Value, Hash>::member( Key const &key ) const {
+    return this->find_slot( key ) != nullptr;
+}
+
+// Return a pointer to the value of the argument key, or nullptr if the key is not in the map
+template <typename Key, typename Value, typename Hash>
+Value *Quadratic_hash_map<Key, Value, Hash>::find( Key const &key ) {
+    Entry *entry = this->find_slot( key );
+
+    return (entry == nullptr) ? nullptr : &entry->entry_value;
+}
+
+template <typename Key, typename Value, typename Hash>
+Value const *Quadratic_hash_map<Key, Value, Hash>::find( Key const &key ) const {
+    Entry const *entry = this->find_slot( key );
+
+    return (entry == nullptr) ? nullptr : &entry->entry_value;
+}
+
+//MUTATORS
+
+// Return the value of the argument key, inserting a default constructed value if the key is not in the map
+template <typename Key, typename Value, typename Hash>
+Value &Quadratic_hash_map<Key, Value, Hash>::operator[]( Key const &key ) {
+    return *try_emplace( key ).first;
+}
+
+template <typename Key, typename Value, typename Hash>
+Value &Quadratic_hash_map<Key, Value, Hash>::operator[]( Key &&key ) {
+    return *try_emplace( std::move( key ) ).first;
+}
+
+// Construct a value from the arguments if the key is not in the map
+// If the key is already present nothing is constructed and the arguments are left untouched
+// Returns a pointer to the value of the key and whether it was inserted
+template <typename Key, typename Value, typename Hash>
+template <typename... Args>
+std::pair<Value *, bool> Quadratic_hash_map<Key, Value, Hash>::try_emplace( Key const &key, Args &&... args ) {
+    std::pair<Entry *, bool> result = this->emplace_slot( key, key, std::forward<Args>( args )... );
+
+    return std::make_pair( &result.first->entry_value, result.second );
+}
+
+// The key is only moved from if it is inserted
+template <typename Key, typename Value, typename Hash>
+template <typename... Args>
+std::pair<Value *, bool> Quadratic_hash_map<Key, Value, Hash>::try_emplace( Key &&key, Args &&... args ) {
+    std::pair<Entry *, bool> result = this->emplace_slot( key, std::move( key ), std::forward<Args>( args )... );
+
+    return std::make_pair( &result.first->entry_value, result.second );
+}
+
+// Construct a value from the arguments if the key is not in the map
+// Unlike std::unordered_map, no entry is built for a key that is already present,
+// so this is the same as try_emplace()
+template <typename Key, typename Value, typename Hash>
+template <typename... Args>
+std::pair<Value *, bool> Quadratic_hash_map<Key, Value, Hash>::emplace( Key const &key, Args &&... args ) {
+    return try_emplace( key, std::forward<Args>( args )... );
+}
+
+// Assign the argument value to the key, inserting the key if it is not in the map
+// Returns a pointer to the value of the key and whether it was inserted
+template <typename Key, typename Value, typename Hash>
+template <typename V>
+std::pair<Value *, bool> Quadratic_hash_map<Key, Value, Hash>::insert_or_assign( Key const &key, V &&value ) {
+    std::pair<Value *, bool> result = try_emplace( key, std::forward<V>( value ) );
+
+    if ( !result.second )
+        *result.first = std::forward<V>( value );
+
+    return result;
+}
+
+template <typename Key, typename Value, typename Hash>
+template <typename V>
+std::pair<Value *, bool> Quadratic_hash_map<Key, Value, Hash>::insert_or_assign( Key &&key, V &&value ) {
+    std::pair<Value *, bool> result = try_emplace( std::move( key ), std::forward<V>( value ) );
+
+    if ( !result.second )
+        *result.first = std::forward<V>( value );
+
+    return result;
+}
+
+// Erases the argument key and its value and returns true on success, false otherwise
+template <typename Key, typename Value, typename Hash>
+bool Quadratic_hash_map<Key, Value, Hash>::erase( Key const &key ) {
+    return this->erase_slot( key );
+}
+
+template <typename K, typename V, typename H>
+std::ostream &operator<<( std::ostream &out, Quadratic_hash_map<K, V, H> const &map ) {
+	for ( int i = 0; i < map.capacity(); ++i ) {
+		if ( map.state( i ) == UNOCCUPIED ) {
+			out << "- ";
+		} else if ( map.state( i ) == ERASED ) {
+			out << "x ";
+		} else {
+			out << map.array[i].entry_key << ':' << map.array[i].entry_value << ' ';
+		}
+	}
+
+	return out;
+}
+
+#endif
@@ -1,48 +1,36 @@
 #ifndef DOUBLE_HASH_TABLE_H
 #define DOUBLE_HASH_TABLE_H
 
-#ifndef nullptr
-#define nullptr 0
-#endif
-
-#include "Exception.h"
-#include "ece250.h"
-
-enum bin_state_t { UNOCCUPIED, OCCUPIED, ERASED };
-
-template <typename Type>
-class Quadratic_hash_table {
+#include <algorithm>
+#include <cstddef>
+#include <iterator>
+#include "Quadratic_hash_engine.h"
+
+// A set of objects stored with quadratic probing
+// Storage, probing and the incremental rehash live in Quadratic_hash_engine
+template <typename Type, typename Hash = Mixing_hash<Type> >
+class Quadratic_hash_table : public Quadratic_hash_engine<Type, Type, Identity_key<Type>, Hash> {
 	private:
-		int count;
-        int countErased;
-		int power;
-		int array_size;
-		int mask;
-		Type *array;
-		bin_state_t *occupied;
-
-		int hash( Type const & ) const;
+		typedef Quadratic_hash_engine<Type, Type, Identity_key<Type>, Hash> Engine;
 
 	public:
-		Quadratic_hash_table( int = 5 );
-		~Quadratic_hash_table();
-		int size() const;
-		int capacity() const;
-		double load_factor() const;
-		bool empty() const;
+		Quadratic_hash_table( int = 5, double = 0.75, Hash const & = Hash() );
+		template <typename Iterator, typename = typename std::iterator_traits<Iterator>::iterator_category>
+		Quadratic_hash_table( Iterator, Iterator, double = 0.75, Hash const & = Hash() );
 		bool member( Type const & ) const;
+		void member_batch( Type const *, std::size_t, bool * ) const;
 		Type bin( int ) const;
 
 		void print() const;
 
-		void insert( Type const & );
+		std::pair<int, bool> insert( Type const & );
+		std::size_t insert_batch( Type const *, std::size_t, bool * = nullptr );
 		bool erase( Type const & );
-		void clear();
 
 	// Friends
 
-	template <typename T>
-	friend std::ostream &operator<<( std::ostream &, Quadratic_hash_table<T> const & );
+	template <typename T, typename H>
+	friend std::ostream &operator<<( std::ostream &, Quadratic_hash_table<T, H> const & );
 };
 
 /////////////////////////////////////////////////////////////////////////
@@ -50,26 +38,21 @@ class Quadratic_hash_table {
 /////////////////////////////////////////////////////////////////////////
 
 // Constructor
-template <typename Type>
-Quadratic_hash_table<Type>::Quadratic_hash_table( int m ):
-count( 0 ), countErased( 0 ),
-power( (m >= 0) ? m : 5),                       // The power of 2 will simply be the argument if positive, but 5 if negative
-array_size( 1 << power ),
-mask( array_size - 1 ),
-array( new Type[array_size] ),
-occupied( new bin_state_t[array_size] ) {
-
-    // Initialize all hash tables to be unoccupied
-	for ( int i = 0; i < array_size; ++i ) {
-		occupied[i] = UNOCCUPIED;
-	}
+// The power of 2 will simply be the first argument if positive, but 5 if negative
+template <typename Type, typename Hash>
+Quadratic_hash_table<Type, Hash>::Quadratic_hash_table( int m, double lf, Hash const &hf ):
+Engine( m, lf, hf ) {
+	// empty constructor
 }
 
-//Destructor
-template  <typename Type>
-Quadratic_hash_table<Type>::~Quadratic_hash_table(){
-    delete [] array;
-    delete [] occupied;
+// Range constructor
+// Inserts the objects in [first, last), sizing the table once when the range can be counted
+// and splitting a large random-access range across threads; see Quadratic_hash_engine::build()
+template <typename Type, typename Hash>
+template <typename Iterator, typename>
+Quadratic_hash_table<Type, Hash>::Quadratic_hash_table( Iterator first, Iterator last, double lf, Hash const &hf ):
+Engine( 5, lf, hf ) {
+    this->build( first, last );
 }
 
 /////////////////////////////////////////////////////////////////////////
@@ -78,161 +61,116 @@ Quadratic_hash_table<Type>::~Quadratic_hash_table(){
 
 //ACCESSORS
 
-// Return the number of elements stored in the hash table
-template <typename Type>
-int Quadratic_hash_table<Type>::size() const{
-    return count;
-}
+// Return true if the argument object is in the hash table
+template <typename Type, typename Hash>
+bool Quadratic_hash_table<Type, Hash>::member( Type const &obj ) const {
+    // Pay for a slice of any rehash in progress
+    this->migrate( Engine::MIGRATE_STEP );
 
-// Return the number of bins in the hash table
-template <typename Type>
-int Quadratic_hash_table<Type>::capacity() const{
-    return array_size;
+    return this->find_slot( obj ) != nullptr;
 }
 
-// Return the load factor of the hash table
-template <typename Type>
-double Quadratic_hash_table<Type>::load_factor() const {
-    return static_cast<double>(count + countErased) / static_cast<double>(array_size);
-}
+// Set out[i] to whether objs[i] is in the hash table, for each of the n objects
+// The objects are hashed and their bins prefetched a batch at a time before any of them
+// is probed for, which overlaps the cache misses of a large table across the batch
+template <typename Type, typename Hash>
+void Quadratic_hash_table<Type, Hash>::member_batch( Type const *objs, std::size_t n, bool *out ) const {
+    std::uint64_t hash_values[Engine::BATCH_SIZE];
 
-// Return true if the hash table is empty, false otherwise
-template <typename Type>
-bool Quadratic_hash_table<Type>::empty() const {
-    return size() == 0;
-}
+    for ( std::size_t start = 0; start < n; start += Engine::BATCH_SIZE ) {
+        int batch = static_cast<int>( std::min<std::size_t>( Engine::BATCH_SIZE, n - start ) );
 
-// Return true if the argument object is in the hash table
-template <typename Type>
-bool Quadratic_hash_table<Type>::member( Type const &obj) const {
-    // Get the hash value for the object that is to be found
-    int bin = hash( obj );
-
-    for(int k = 0; k < array_size; k++){
-        //Quadratic probing
-        bin = (bin + k) % array_size;
-
-        // If an UNOCCUPIED bin is reached before finding the object, then the object can't be in the hash table
-        if(occupied[bin] == UNOCCUPIED){
-            return false;
+        // Pay for the same slice of any rehash in progress as the equivalent member() calls
+        // This is done first as migration may release the arrays being prefetched
+        this->migrate( batch * Engine::MIGRATE_STEP );
+
+        for ( int i = 0; i < batch; ++i ) {
+            hash_values[i] = this->hash( objs[start + i] );
+            this->prefetch_hashed( hash_values[i] );
         }
 
-        // Only return true if the bin is OCCUPIED AND the argument object is equal to the array element
-        if(occupied[bin] == OCCUPIED){
-            if(array[bin] == obj)
-                return true;
+        for ( int i = 0; i < batch; ++i ) {
+            out[start + i] = this->find_hashed( objs[start + i], hash_values[i] ) != nullptr;
         }
     }
-
-    return false;
 }
 
-// Return the content of bin n
-template <typename Type>
-Type Quadratic_hash_table<Type>::bin(int n) const {
-    return array[n];
+// Return the content of bin n, or a default object if the bin is not OCCUPIED
+template <typename Type, typename Hash>
+Type Quadratic_hash_table<Type, Hash>::bin( int n ) const {
+    return (this->state( n ) == OCCUPIED) ? this->array[n] : Type();
 }
 
 // Print contents in all OCCUPIED bins, null otherwise
-template <typename Type>
-void Quadratic_hash_table<Type>::print() const {
-    for(int i = 0; i < capacity(); i++){
-        std::cout << "bin(" << i << "): " << array[i] << std::endl;
+template <typename Type, typename Hash>
+void Quadratic_hash_table<Type, Hash>::print() const {
+    for ( int i = 0; i < this->capacity(); i++ ) {
+        std::cout << "bin(" << i << "): ";
+
+        if ( this->state( i ) == OCCUPIED ) {
+            std::cout << this->array[i] << std::endl;
+        } else {
+            std::cout << "null" << std::endl;
+        }
     }
 }
 
 //MUTATORS
 
-// Insert an object into the hash table
-template <typename Type>
-void Quadratic_hash_table<Type>::insert(Type const &obj) {
-    // Throw exception if the hash table is full
-    if(size() == capacity())
-        throw overflow();
-    // Do nothing if the hash table is not full and the argument object is already in the hash table
-    if(count < array_size && member(obj))
-        return;
-
-    int bin = hash( obj );                         // Get the hash value for the object that is to be inserted
-    for(int k = 0; k < array_size; k++){
-        // Quadratic probing
-        bin = (bin + k) % array_size;
-
-        // Look for an unoccupied bin and insert into that bin
-        if(occupied[bin] != OCCUPIED){
-            array[bin] = obj;
-            count++;
-            // Decrement the countErased variable if the bin was previously erased
-            if(occupied[bin] == ERASED)
-                countErased--;
-            occupied[bin] = OCCUPIED;
-            return;
-        }
-    }
+// Insert an object into the hash table with a single probe sequence
+// Does nothing if the argument object is already in the hash table
+// Returns the bin holding the object and true if it was inserted, false if it was already present
+template <typename Type, typename Hash>
+std::pair<int, bool> Quadratic_hash_table<Type, Hash>::insert( Type const &obj ) {
+    std::pair<Type *, bool> result = this->emplace_slot( obj, obj );
+
+    return std::make_pair( static_cast<int>( result.first - this->array ), result.second );
 }
 
-// Erases an object from the hash table and returns true on success, false otherwise
-template <typename Type>
-bool Quadratic_hash_table<Type>::erase(Type const &obj) {
-    // Get the hash value for the object that is to be erased
-    int bin = hash( obj );
-
-    for(int k = 0; k < array_size; k++){
-        // Quadratic probing
-        bin = (bin + k) % array_size;
-
-        // If an UNOCCUPIED bin is reached before finding the object, then the object can't be in the hash table
-        if(occupied[bin] == UNOCCUPIED){
-            return false;
-        }
-        // If the bin is OCCUPIED and the array contains the object, then set the bin to ERASED
-        if(occupied[bin] == OCCUPIED) {
-            if (array[bin] == obj) {
-                occupied[bin] = ERASED;
-                count--;
-                countErased++;
-                return true;
-            }
-        }
-    }
+// Insert each of the n objects into the hash table, prefetching their bins a batch at a time
+// If inserted is not nullptr, inserted[i] is set to whether objs[i] was newly inserted
+// Returns the number of objects that were newly inserted
+template <typename Type, typename Hash>
+std::size_t Quadratic_hash_table<Type, Hash>::insert_batch( Type const *objs, std::size_t n, bool *inserted ) {
+    std::uint64_t hash_values[Engine::BATCH_SIZE];
+    std::size_t inserted_count = 0;
 
-    return false;
+    for ( std::size_t start = 0; start < n; start += Engine::BATCH_SIZE ) {
+        int batch = static_cast<int>( std::min<std::size_t>( Engine::BATCH_SIZE, n - start ) );
 
-}
+        for ( int i = 0; i < batch; ++i ) {
+            hash_values[i] = this->hash( objs[start + i] );
+            this->prefetch_hashed( hash_values[i] );
+        }
 
-// Clear all elements in the hash table by setting all bins to UNOCCUPIED and setting the counts to 0
-template <typename Type>
-void Quadratic_hash_table<Type>::clear() {
-    for (int i = 0; i < array_size; i++){
-        occupied[i] = UNOCCUPIED;
-    }
-    count = 0;
-    countErased = 0;
-}
+        // A rehash started part way through a batch only wastes the remaining prefetches,
+        // since every probe reduces its hash value with the current mask
+        for ( int i = 0; i < batch; ++i ) {
+            bool is_new = this->emplace_hashed( objs[start + i], hash_values[i], objs[start + i] ).second;
 
-/////////////////////////////////////////////////////////////////////////
-//                      Private member functions                       //
-/////////////////////////////////////////////////////////////////////////
+            if ( inserted != nullptr )
+                inserted[start + i] = is_new;
 
+            if ( is_new )
+                inserted_count++;
+        }
+    }
 
-// Hash function that returns a hash value
-template <typename Type>
-int Quadratic_hash_table<Type>::hash( Type const &obj ) const {
-    // Calculate the hash value by taking the object cast as an integer module M
-    // Cast the object as an int to account for doubles
-    int hash_value = static_cast<int>(obj) % array_size;
+    return inserted_count;
+}
 
-    // Return the hash value if it's positive
-    // If the hash value is negative, return hash value + M
-    return (hash_value >= 0) ? hash_value : hash_value + array_size;
+// Erases an object from the hash table and returns true on success, false otherwise
+template <typename Type, typename Hash>
+bool Quadratic_hash_table<Type, Hash>::erase( Type const &obj ) {
+    return this->erase_slot( obj );
 }
 
-template <typename T>
-std::ostream &operator<<( std::ostream &out, Quadratic_hash_table<T> const &hash ) {
+template <typename T, typename H>
+std::ostream &operator<<( std::ostream &out, Quadratic_hash_table<T, H> const &hash ) {
 	for ( int i = 0; i < hash.capacity(); ++i ) {
-		if ( hash.occupied[i] == UNOCCUPIED ) {
+		if ( hash.state( i ) == UNOCCUPIED ) {
 			out << "- ";
-		} else if ( hash.occupied[i] == ERASED ) {
+		} else if ( hash.state( i ) == ERASED ) {
 			out << "x ";
 		} else {
 			out << hash.array[i] << ' ';
@@ -0,0 +1,377 @@
+#ifndef ROBIN_HOOD_HASH_TABLE_H
+#define ROBIN_HOOD_HASH_TABLE_H
+
+// nullptr is a keyword rather than a macro, so only fall back to 0 on pre-C++11 compilers
+#if __cplusplus < 201103L && !defined(nullptr)
+#define nullptr 0
+#endif
+
+#include <cstdint>
+#include <new>
+#include <utility>
+#include "Exception.h"
+#include "ece250.h"
+#include "Hash_function.h"
+
+// A set of objects stored with linear probing and Robin Hood displacement
+// It has the same interface as Quadratic_hash_table
+//
+// Every bin records how far its object is from the bin it hashes to
+// Insertion lets an object take the bin of any object that is closer to its own home bin,
+// which keeps the spread of probe lengths small, and a lookup can stop as soon as it
+// reaches an object closer to home than the probe itself
+// Erasing shifts the following displaced objects back by one bin instead of leaving an
+// ERASED marker, so the table never accumulates tombstones however much it is churned
+template <typename Type, typename Hash = Mixing_hash<Type> >
+class Robin_hood_hash_table {
+	private:
+		int count;
+		int power;
+		int array_size;
+		int mask;
+		Type *array;
+		// 0 for an empty bin, otherwise one more than the distance of the object from its home bin
+		std::uint16_t *distance;
+		Hash hash_function;
+		double max_load;
+
+		// Distances are stored in 16 bits, so the table grows before any probe gets this long
+		static const int MAX_DISTANCE = 65535;
+
+		std::uint64_t hash( Type const & ) const;
+		int find( Type const & ) const;
+		void rehash( int );
+
+		static Type *allocate_slots( int );
+		static std::uint16_t *allocate_distances( int );
+		static void release( Type *, std::uint16_t *, int );
+
+		// The arrays are owned by the table and are not shared between tables
+		Robin_hood_hash_table( Robin_hood_hash_table const & );
+		Robin_hood_hash_table &operator=( Robin_hood_hash_table const & );
+
+	public:
+		Robin_hood_hash_table( int = 5, double = 0.875, Hash const & = Hash() );
+		~Robin_hood_hash_table();
+		int size() const;
+		int capacity() const;
+		double load_factor() const;
+		double max_load_factor() const;
+		bool empty() const;
+		bool member( Type const & ) const;
+		Type bin( int ) const;
+
+		void print() const;
+
+		void max_load_factor( double );
+		std::pair<int, bool> insert( Type const & );
+		bool erase( Type const & );
+		void clear();
+
+	// Friends
+
+	template <typename T, typename H>
+	friend std::ostream &operator<<( std::ostream &, Robin_hood_hash_table<T, H> const & );
+};
+
+/////////////////////////////////////////////////////////////////////////
+//                   Constructors and Destructors                      //
+/////////////////////////////////////////////////////////////////////////
+
+// Constructor
+template <typename Type, typename Hash>
+Robin_hood_hash_table<Type, Hash>::Robin_hood_hash_table( int m, double lf, Hash const &hf ):
+count( 0 ),
+power( (m >= 0) ? m : 5),                       // The power of 2 will simply be the argument if positive, but 5 if negative
+array_size( 1 << power ),
+mask( array_size - 1 ),
+array( nullptr ),
+distance( nullptr ),
+hash_function( hf ),
+max_load( lf ) {
+    // The maximum load factor must leave at least one empty bin so that probing terminates
+    if ( lf <= 0.0 || lf >= 1.0 ) {
+        throw illegal_argument();
+    }
+
+    array = allocate_slots( array_size );
+    distance = allocate_distances( array_size );
+}
+
+// Destructor
+template <typename Type, typename Hash>
+Robin_hood_hash_table<Type, Hash>::~Robin_hood_hash_table() {
+    release( array, distance, array_size );
+}
+
+/////////////////////////////////////////////////////////////////////////
+//                     Public Member Functions                         //
+/////////////////////////////////////////////////////////////////////////
+
+//ACCESSORS
+
+// Return the number of elements stored in the hash table
+template <typename Type, typename Hash>
+int Robin_hood_hash_table<Type, Hash>::size() const {
+    return count;
+}
+
+// Return the number of bins in the hash table
+template <typename Type, typename Hash>
+int Robin_hood_hash_table<Type, Hash>::capacity() const {
+    return array_size;
+}
+
+// Return the load factor of the hash table
+// There are no ERASED bins, so this is simply the fraction of bins holding an object
+template <typename Type, typename Hash>
+double Robin_hood_hash_table<Type, Hash>::load_factor() const {
+    return static_cast<double>(count) / static_cast<double>(array_size);
+}
+
+// Return the load factor at which the hash table grows
+template <typename Type, typename Hash>
+double Robin_hood_hash_table<Type, Hash>::max_load_factor() const {
+    return max_load;
+}
+
+// Return true if the hash table is empty, false otherwise
+template <typename Type, typename Hash>
+bool Robin_hood_hash_table<Type, Hash>::empty() const {
+    return size() == 0;
+}
+
+// Return true if the argument object is in the hash table
+template <typename Type, typename Hash>
+bool Robin_hood_hash_table<Type, Hash>::member( Type const &obj ) const {
+    return find( obj ) >= 0;
+}
+
+// Return the content of bin n, or a default object if the bin is empty
+template <typename Type, typename Hash>
+Type Robin_hood_hash_table<Type, Hash>::bin( int n ) const {
+    return (distance[n] != 0) ? array[n] : Type();
+}
+
+// Print contents in all occupied bins, null otherwise
+template <typename Type, typename Hash>
+void Robin_hood_hash_table<Type, Hash>::print() const {
+    for ( int i = 0; i < capacity(); i++ ) {
+        std::cout << "bin(" << i << "): ";
+
+        if ( distance[i] != 0 ) {
+            std::cout << array[i] << std::endl;
+        } else {
+            std::cout << "null" << std::endl;
+        }
+    }
+}
+
+//MUTATORS
+
+// Set the load factor at which the hash table grows
+// The new limit takes effect on the next insertion
+template <typename Type, typename Hash>
+void Robin_hood_hash_table<Type, Hash>::max_load_factor( double lf ) {
+    if ( lf <= 0.0 || lf >= 1.0 )
+        throw illegal_argument();
+
+    max_load = lf;
+}
+
+// Insert an object into the hash table
+// Returns the bin holding the object and true if it was inserted, false if it was already present
+template <typename Type, typename Hash>
+std::pair<int, bool> Robin_hood_hash_table<Type, Hash>::insert( Type const &obj ) {
+    int found = find( obj );
+
+    if ( found >= 0 )
+        return std::make_pair( found, false );
+
+    if ( count + 1 > max_load * array_size )
+        rehash( power + 1 );
+
+    // The object being carried starts as a copy of the argument and becomes whichever
+    // object was displaced each time a richer bin is taken
+    Type carried( obj );
+    int carried_distance = 1;
+    int bin = static_cast<int>( hash( obj ) & mask );
+    int landed = -1;
+
+    while ( true ) {
+        // Grow if a probe would become too long to record
+        if ( carried_distance > MAX_DISTANCE ) {
+            rehash( power + 1 );
+
+            // If the argument object was already placed it has been rehashed along with
+            // the others, and only the displaced object is left to insert
+            if ( landed >= 0 ) {
+                insert( carried );
+                return std::make_pair( find( obj ), true );
+            }
+
+            carried_distance = 1;
+            bin = static_cast<int>( hash( carried ) & mask );
+            continue;
+        }
+
+        // An empty bin ends the insertion
+        if ( distance[bin] == 0 ) {
+            new ( array + bin ) Type( std::move( carried ) );
+            distance[bin] = static_cast<std::uint16_t>( carried_distance );
+            count++;
+
+            return std::make_pair( (landed >= 0) ? landed : bin, true );
+        }
+
+        // Take the bin from an object that is closer to its home than the carried object,
+        // and carry that object on instead
+        if ( distance[bin] < carried_distance ) {
+            std::swap( carried, array[bin] );
+
+            int displaced_distance = distance[bin];
+            distance[bin] = static_cast<std::uint16_t>( carried_distance );
+            carried_distance = displaced_distance;
+
+            if ( landed < 0 )
+                landed = bin;
+        }
+
+        // Linear probing
+        bin = (bin + 1) & mask;
+        carried_distance++;
+    }
+}
+
+// Erases an object from the hash table and returns true on success, false otherwise
+// The objects after it that are not in their home bins are shifted back by one bin
+template <typename Type, typename Hash>
+bool Robin_hood_hash_table<Type, Hash>::erase( Type const &obj ) {
+    int bin = find( obj );
+
+    if ( bin < 0 )
+        return false;
+
+    int next = (bin + 1) & mask;
+
+    while ( distance[next] > 1 ) {
+        array[bin] = std::move( array[next] );
+        distance[bin] = static_cast<std::uint16_t>( distance[next] - 1 );
+        bin = next;
+        next = (next + 1) & mask;
+    }
+
+    array[bin].~Type();
+    distance[bin] = 0;
+    count--;
+
+    return true;
+}
+
+// Clear all elements in the hash table by destroying them and marking every bin empty
+template <typename Type, typename Hash>
+void Robin_hood_hash_table<Type, Hash>::clear() {
+    for ( int i = 0; i < array_size; i++ ) {
+        if ( distance[i] != 0 )
+            array[i].~Type();
+
+        distance[i] = 0;
+    }
+
+    count = 0;
+}
+
+/////////////////////////////////////////////////////////////////////////
+//                      Private member functions                       //
+/////////////////////////////////////////////////////////////////////////
+
+// Hash function that returns the full hash value of an object
+template <typename Type, typename Hash>
+std::uint64_t Robin_hood_hash_table<Type, Hash>::hash( Type const &obj ) const {
+    return static_cast<std::uint64_t>( hash_function( obj ) );
+}
+
+// Return the bin holding the argument object, or -1 if it is not in the hash table
+// The probe stops at an empty bin or at an object closer to its home bin than the probe,
+// since insertion would have displaced that object
+template <typename Type, typename Hash>
+int Robin_hood_hash_table<Type, Hash>::find( Type const &obj ) const {
+    int bin = static_cast<int>( hash( obj ) & mask );
+
+    for ( int d = 1; d <= distance[bin]; d++ ) {
+        if ( distance[bin] == d && array[bin] == obj )
+            return bin;
+
+        bin = (bin + 1) & mask;
+    }
+
+    return -1;
+}
+
+// Move every object into new arrays with 2^p bins
+template <typename Type, typename Hash>
+void Robin_hood_hash_table<Type, Hash>::rehash( int p ) {
+    Type *old_array = array;
+    std::uint16_t *old_distance = distance;
+    int old_array_size = array_size;
+
+    power = p;
+    array_size = 1 << power;
+    mask = array_size - 1;
+    array = allocate_slots( array_size );
+    distance = allocate_distances( array_size );
+    count = 0;
+
+    for ( int i = 0; i < old_array_size; ++i ) {
+        if ( old_distance[i] != 0 ) {
+            insert( old_array[i] );
+        }
+    }
+
+    release( old_array, old_distance, old_array_size );
+}
+
+// Allocate uninitialized storage for n objects
+template <typename Type, typename Hash>
+Type *Robin_hood_hash_table<Type, Hash>::allocate_slots( int n ) {
+    return static_cast<Type *>( ::operator new( n * sizeof( Type ) ) );
+}
+
+// Allocate n distances, all marking empty bins
+template <typename Type, typename Hash>
+std::uint16_t *Robin_hood_hash_table<Type, Hash>::allocate_distances( int n ) {
+    std::uint16_t *distances = new std::uint16_t[n];
+
+    for ( int i = 0; i < n; ++i ) {
+        distances[i] = 0;
+    }
+
+    return distances;
+}
+
+// Destroy the objects in all occupied bins and free both arrays
+template <typename Type, typename Hash>
+void Robin_hood_hash_table<Type, Hash>::release( Type *slots, std::uint16_t *distances, int n ) {
+    for ( int i = 0; i < n; ++i ) {
+        if ( distances[i] != 0 )
+            slots[i].~Type();
+    }
+
+    ::operator delete( slots );
+    delete [] distances;
+}
+
+template <typename T, typename H>
+std::ostream &operator<<( std::ostream &out, Robin_hood_hash_table<T, H> const &hash ) {
+	for ( int i = 0; i < hash.capacity(); ++i ) {
+		if ( hash.distance[i] == 0 ) {
+			out << "- ";
+		} else {
+			out << hash.array[i] << ' ';
+		}
+	}
+
+	return out;
+}
+
+#endif
@@ -0,0 +1,488 @@
+#ifndef SWISS_HASH_TABLE_H
+#define SWISS_HASH_TABLE_H
+
+#include <cstdint>
+#include <cstddef>
+#include <cstring>
+#include <new>
+#include <utility>
+#include "Exception.h"
+#include "ece250.h"
+#include "Hash_function.h"
+
+#if defined(__SSE2__)
+#include <emmintrin.h>
+#endif
+
+/////////////////////////////////////////////////////////////////////////
+//                            Control bytes                            //
+/////////////////////////////////////////////////////////////////////////
+
+// Every bin has one control byte
+// A full bin stores the low 7 bits of its object's hash value (the fingerprint),
+// so the high bit being set marks a bin that holds no object
+const signed char CONTROL_EMPTY   = -128;           // 0b10000000
+const signed char CONTROL_DELETED = -2;             // 0b11111110
+
+// A group of 16 consecutive control bytes that is matched in a single step
+// With SSE2 each match is one compare plus one movemask, otherwise the bytes are scanned one at a time
+// Each match returns a bit mask with bit i set if control byte i matches
+class Control_group {
+	public:
+		static const int WIDTH = 16;
+		static const int WIDTH_POWER = 4;
+
+		explicit Control_group( signed char const * );
+
+		unsigned int match( signed char ) const;
+		unsigned int match_empty() const;
+		unsigned int match_empty_or_deleted() const;
+
+	private:
+#if defined(__SSE2__)
+		__m128i control;
+#else
+		signed char control[WIDTH];
+#endif
+};
+
+#if defined(__SSE2__)
+
+inline Control_group::Control_group( signed char const *ctrl ):
+control( _mm_loadu_si128( reinterpret_cast<__m128i const *>( ctrl ) ) ) {
+	// empty constructor
+}
+
+inline unsigned int Control_group::match( signed char fingerprint ) const {
+    return static_cast<unsigned int>( _mm_movemask_epi8( _mm_cmpeq_epi8( control, _mm_set1_epi8( fingerprint ) ) ) );
+}
+
+inline unsigned int Control_group::match_empty() const {
+    return match( CONTROL_EMPTY );
+}
+
+// Both EMPTY and DELETED have the high bit set, which is exactly what movemask extracts
+inline unsigned int Control_group::match_empty_or_deleted() const {
+    return static_cast<unsigned int>( _mm_movemask_epi8( control ) );
+}
+
+#else
+
+inline Control_group::Control_group( signed char const *ctrl ) {
+    std::memcpy( control, ctrl, WIDTH );
+}
+
+inline unsigned int Control_group::match( signed char fingerprint ) const {
+    unsigned int bits = 0;
+
+    for ( int i = 0; i < WIDTH; ++i ) {
+        bits |= static_cast<unsigned int>( control[i] == fingerprint ) << i;
+    }
+
+    return bits;
+}
+
+inline unsigned int Control_group::match_empty() const {
+    return match( CONTROL_EMPTY );
+}
+
+inline unsigned int Control_group::match_empty_or_deleted() const {
+    unsigned int bits = 0;
+
+    for ( int i = 0; i < WIDTH; ++i ) {
+        bits |= static_cast<unsigned int>( control[i] < 0 ) << i;
+    }
+
+    return bits;
+}
+
+#endif
+
+// Return the index of the lowest set bit of a non-zero match
+inline int lowest_match( unsigned int bits ) {
+#if defined(__GNUC__)
+    return __builtin_ctz( bits );
+#else
+    int i = 0;
+
+    while ( (bits & 1) == 0 ) {
+        bits >>= 1;
+        ++i;
+    }
+
+    return i;
+#endif
+}
+
+/////////////////////////////////////////////////////////////////////////
+//                          Swiss hash table                           //
+/////////////////////////////////////////////////////////////////////////
+
+// An alternative layout to Quadratic_hash_table with the same interface
+// The bins are split into groups of 16 and probing visits whole groups quadratically
+// A lookup compares the fingerprints of all 16 bins of a group at once and only
+// touches the array of objects for bins whose fingerprint matches, so most misses
+// never read an object and most hits read exactly one
+//
+// Objects are only constructed while their control byte marks the bin as full, so erase()
+// and clear() destroy them, and a rehash moves rather than copies them
+template <typename Type, typename Hash = Mixing_hash<Type> >
+class Swiss_hash_table {
+	private:
+		int count;
+		int countErased;
+		int power;
+		int array_size;
+		int group_mask;
+		Type *array;
+		signed char *control;
+		Hash hash_function;
+		double max_load;
+
+		std::uint64_t hash( Type const & ) const;
+		int find( Type const &, std::uint64_t ) const;
+		int find_free( std::uint64_t ) const;
+		void rehash( int );
+
+		static Type *allocate( int );
+		static signed char *control_of( Type *, int );
+		static void release( Type *, signed char *, int );
+
+		// The arrays are owned by the table and are not shared between tables
+		Swiss_hash_table( Swiss_hash_table const & );
+		Swiss_hash_table &operator=( Swiss_hash_table const & );
+
+	public:
+		Swiss_hash_table( int = 5, double = 0.875, Hash const & = Hash() );
+		~Swiss_hash_table();
+		int size() const;
+		int capacity() const;
+		double load_factor() const;
+		double max_load_factor() const;
+		bool empty() const;
+		bool member( Type const & ) const;
+		Type bin( int ) const;
+
+		void print() const;
+
+		void max_load_factor( double );
+		std::pair<int, bool> insert( Type const & );
+		bool erase( Type const & );
+		void clear();
+
+	// Friends
+
+	template <typename T, typename H>
+	friend std::ostream &operator<<( std::ostream &, Swiss_hash_table<T, H> const & );
+};
+
+/////////////////////////////////////////////////////////////////////////
+//                   Constructors and Destructors                      //
+/////////////////////////////////////////////////////////////////////////
+
+// Constructor
+// The table always holds at least one group, so the power is at least 4
+template <typename Type, typename Hash>
+Swiss_hash_table<Type, Hash>::Swiss_hash_table( int m, double lf, Hash const &hf ):
+count( 0 ), countErased( 0 ),
+power( (m >= Control_group::WIDTH_POWER && m <= 30) ? m : ((m >= 0 && m < Control_group::WIDTH_POWER) ? Control_group::WIDTH_POWER : 5) ),
+array_size( 1 << power ),
+group_mask( (array_size / Control_group::WIDTH) - 1 ),
+array( nullptr ),
+control( nullptr ),
+hash_function( hf ),
+max_load( lf ) {
+    // The maximum load factor must leave at least one EMPTY bin so that probing terminates
+    if ( lf <= 0.0 || lf >= 1.0 )
+        throw illegal_argument();
+
+    array = allocate( array_size );
+    control = control_of( array, array_size );
+}
+
+// Destructor
+template <typename Type, typename Hash>
+Swiss_hash_table<Type, Hash>::~Swiss_hash_table() {
+    release( array, control, array_size );
+}
+
+/////////////////////////////////////////////////////////////////////////
+//                     Public Member Functions                         //
+/////////////////////////////////////////////////////////////////////////
+
+//ACCESSORS
+
+// Return the number of elements stored in the hash table
+template <typename Type, typename Hash>
+int Swiss_hash_table<Type, Hash>::size() const {
+    return count;
+}
+
+// Return the number of bins in the hash table
+template <typename Type, typename Hash>
+int Swiss_hash_table<Type, Hash>::capacity() const {
+    return array_size;
+}
+
+// Return the load factor of the hash table, counting DELETED bins
+template <typename Type, typename Hash>
+double Swiss_hash_table<Type, Hash>::load_factor() const {
+    return static_cast<double>(count + countErased) / static_cast<double>(array_size);
+}
+
+// Return the load factor at which the hash table grows or compacts its DELETED bins
+template <typename Type, typename Hash>
+double Swiss_hash_table<Type, Hash>::max_load_factor() const {
+    return max_load;
+}
+
+// Return true if the hash table is empty, false otherwise
+template <typename Type, typename Hash>
+bool Swiss_hash_table<Type, Hash>::empty() const {
+    return size() == 0;
+}
+
+// Return true if the argument object is in the hash table
+template <typename Type, typename Hash>
+bool Swiss_hash_table<Type, Hash>::member( Type const &obj ) const {
+    return find( obj, hash( obj ) ) >= 0;
+}
+
+// Return the content of bin n, or a default object if the bin is not full
+template <typename Type, typename Hash>
+Type Swiss_hash_table<Type, Hash>::bin( int n ) const {
+    return (control[n] >= 0) ? array[n] : Type();
+}
+
+// Print contents in all full bins, null otherwise
+template <typename Type, typename Hash>
+void Swiss_hash_table<Type, Hash>::print() const {
+    for ( int i = 0; i < capacity(); i++ ) {
+        std::cout << "bin(" << i << "): ";
+
+        if ( control[i] >= 0 ) {
+            std::cout << array[i] << std::endl;
+        } else {
+            std::cout << "null" << std::endl;
+        }
+    }
+}
+
+//MUTATORS
+
+// Set the load factor at which the hash table grows or compacts its DELETED bins
+template <typename Type, typename Hash>
+void Swiss_hash_table<Type, Hash>::max_load_factor( double lf ) {
+    if ( lf <= 0.0 || lf >= 1.0 )
+        throw illegal_argument();
+
+    max_load = lf;
+}
+
+// Insert an object into the hash table
+// Returns the bin holding the object and true if it was inserted, false if it was already present
+template <typename Type, typename Hash>
+std::pair<int, bool> Swiss_hash_table<Type, Hash>::insert( Type const &obj ) {
+    std::uint64_t hash_value = hash( obj );
+
+    // Do nothing if the argument object is already in the hash table
+    int found = find( obj, hash_value );
+
+    if ( found >= 0 )
+        return std::make_pair( found, false );
+
+    // Rehash before this insertion would push the table past its maximum load factor
+    // The table doubles if the live objects alone fill more than half of the maximum load,
+    // otherwise it keeps its size and only compacts away the DELETED bins
+    if ( count + countErased + 1 > max_load * array_size ) {
+        rehash( (2*(count + 1) > max_load * array_size) ? power + 1 : power );
+    }
+
+    int bin = find_free( hash_value );
+
+    if ( control[bin] == CONTROL_DELETED )
+        countErased--;
+
+    new ( array + bin ) Type( obj );
+    control[bin] = static_cast<signed char>( hash_value & 0x7f );
+    count++;
+
+    return std::make_pair( bin, true );
+}
+
+// Erases an object from the hash table and returns true on success, false otherwise
+template <typename Type, typename Hash>
+bool Swiss_hash_table<Type, Hash>::erase( Type const &obj ) {
+    int bin = find( obj, hash( obj ) );
+
+    if ( bin < 0 )
+        return false;
+
+    array[bin].~Type();
+
+    // A probe only continues past a group that has no EMPTY bins, so if the group
+    // already has an EMPTY bin no probe sequence depends on this bin being full
+    // and it can be marked EMPTY instead of leaving a DELETED marker
+    int group_start = bin & ~(Control_group::WIDTH - 1);
+
+    if ( Control_group( control + group_start ).match_empty() != 0 ) {
+        control[bin] = CONTROL_EMPTY;
+    } else {
+        control[bin] = CONTROL_DELETED;
+        countErased++;
+    }
+
+    count--;
+
+    return true;
+}
+
+// Clear all elements in the hash table by destroying them and marking every control byte EMPTY
+template <typename Type, typename Hash>
+void Swiss_hash_table<Type, Hash>::clear() {
+    for ( int i = 0; i < array_size; ++i ) {
+        if ( control[i] >= 0 )
+            array[i].~Type();
+    }
+
+    std::memset( control, CONTROL_EMPTY, array_size );
+    count = 0;
+    countErased = 0;
+}
+
+/////////////////////////////////////////////////////////////////////////
+//                      Private member functions                       //
+/////////////////////////////////////////////////////////////////////////
+
+// Hash function that returns the full hash value of an object
+// The low 7 bits form the fingerprint and the remaining bits select the first group
+template <typename Type, typename Hash>
+std::uint64_t Swiss_hash_table<Type, Hash>::hash( Type const &obj ) const {
+    return static_cast<std::uint64_t>( hash_function( obj ) );
+}
+
+// Return the bin holding the argument object, or -1 if it is not in the hash table
+template <typename Type, typename Hash>
+int Swiss_hash_table<Type, Hash>::find( Type const &obj, std::uint64_t hash_value ) const {
+    signed char fingerprint = static_cast<signed char>( hash_value & 0x7f );
+    int group = static_cast<int>( (hash_value >> 7) & group_mask );
+
+    for ( int k = 0; k <= group_mask; k++ ) {
+        // Quadratic probing over groups
+        group = (group + k) & group_mask;
+
+        int group_start = group * Control_group::WIDTH;
+        Control_group candidates( control + group_start );
+
+        // Only bins with a matching fingerprint are compared against the object
+        for ( unsigned int bits = candidates.match( fingerprint ); bits != 0; bits &= bits - 1 ) {
+            int bin = group_start + lowest_match( bits );
+
+            if ( array[bin] == obj )
+                return bin;
+        }
+
+        // An EMPTY bin ends the probe sequence, since insert would have used it
+        if ( candidates.match_empty() != 0 )
+            return -1;
+    }
+
+    return -1;
+}
+
+// Return the first EMPTY or DELETED bin in the probe sequence of a hash value
+template <typename Type, typename Hash>
+int Swiss_hash_table<Type, Hash>::find_free( std::uint64_t hash_value ) const {
+    int group = static_cast<int>( (hash_value >> 7) & group_mask );
+
+    for ( int k = 0; k <= group_mask; k++ ) {
+        group = (group + k) & group_mask;
+
+        int group_start = group * Control_group::WIDTH;
+        unsigned int bits = Control_group( control + group_start ).match_empty_or_deleted();
+
+        if ( bits != 0 )
+            return group_start + lowest_match( bits );
+    }
+
+    // Not reached: the maximum load factor always leaves a free bin
+    return -1;
+}
+
+// Move every object into new arrays with 2^p bins, dropping all DELETED markers
+// The new arrays are allocated before anything is changed, so a table that cannot grow
+// past 2^30 bins, or whose allocation fails, is left as it was
+template <typename Type, typename Hash>
+void Swiss_hash_table<Type, Hash>::rehash( int p ) {
+    if ( p > 30 )
+        throw overflow();
+
+    Type *new_array = allocate( 1 << p );
+
+    Type *old_array = array;
+    signed char *old_control = control;
+    int old_array_size = array_size;
+
+    power = p;
+    array_size = 1 << power;
+    group_mask = (array_size / Control_group::WIDTH) - 1;
+    array = new_array;
+    control = control_of( new_array, array_size );
+    countErased = 0;
+
+    for ( int i = 0; i < old_array_size; ++i ) {
+        if ( old_control[i] >= 0 ) {
+            std::uint64_t hash_value = hash( old_array[i] );
+            int bin = find_free( hash_value );
+
+            new ( array + bin ) Type( std::move( old_array[i] ) );
+            control[bin] = old_control[i];
+        }
+    }
+
+    release( old_array, old_control, old_array_size );
+}
+
+// Allocate uninitialized storage for n objects followed by their n control bytes, all EMPTY
+// A single allocation holds both arrays, so there is no second allocation to fail
+template <typename Type, typename Hash>
+Type *Swiss_hash_table<Type, Hash>::allocate( int n ) {
+    Type *slots = static_cast<Type *>( ::operator new( static_cast<std::size_t>( n ) * (sizeof( Type ) + 1) ) );
+    std::memset( control_of( slots, n ), CONTROL_EMPTY, n );
+
+    return slots;
+}
+
+// Return the control bytes stored after the n objects of an allocation
+template <typename Type, typename Hash>
+signed char *Swiss_hash_table<Type, Hash>::control_of( Type *slots, int n ) {
+    return reinterpret_cast<signed char *>( slots + n );
+}
+
+// Destroy the objects in all full bins and free the allocation
+template <typename Type, typename Hash>
+void Swiss_hash_table<Type, Hash>::release( Type *slots, signed char *controls, int n ) {
+    for ( int i = 0; i < n; ++i ) {
+        if ( controls[i] >= 0 )
+            slots[i].~Type();
+    }
+
+    ::operator delete( slots );
+}
+
+template <typename T, typename H>
+std::ostream &operator<<( std::ostream &out, Swiss_hash_table<T, H> const &hash ) {
+	for ( int i = 0; i < hash.capacity(); ++i ) {
+		if ( hash.control[i] == CONTROL_EMPTY ) {
+			out << "- ";
+		} else if ( hash.control[i] == CONTROL_DELETED ) {
+			out << "x ";
+		} else {
+			out << hash.array[i] << ' ';
+		}
+	}
+
+	return out;
+}
+
+#endif
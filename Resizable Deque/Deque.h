@@ -0,0 +1,46 @@
+#ifndef DEQUE_H
+#define DEQUE_H
+
+#include "Resizable_deque.h"
+#include "Segmented_deque.h"
+#include "Small_deque.h"
+
+// Storage layouts for Deque
+// Each layout names the deque that implements it, and all three deques support:
+//     construction from an initial capacity, copy and move construction and assignment, swap()
+//     front(), back(), size(), empty(), capacity()
+//     operator[] (unchecked), iterator and const_iterator (random access), begin(), end()
+//     push_front(), push_back() of one object or of a range [first, last)
+//     pop_front() and pop_back() of one object or of n objects
+//     reserve(), shrink_to_fit(), clear()
+// Beyond these, only Resizable_deque has as_spans() and only Small_deque has is_inline()
+
+// One circular array, doubled and copied when full: the most compact choice for small queues
+class Contiguous_layout {
+	public:
+		template <typename Type>
+		using deque = Resizable_deque<Type>;
+};
+
+// Fixed-size blocks reached through a map: growth never copies elements and references stay valid
+class Segmented_layout {
+	public:
+		template <typename Type>
+		using deque = Segmented_deque<Type>;
+};
+
+// Up to N elements inside the deque object itself, and a circular array on the heap past that:
+// for many short-lived deques that rarely hold more than a few elements
+template <int N>
+class Inline_layout {
+	public:
+		template <typename Type>
+		using deque = Small_deque<Type, N>;
+};
+
+// A deque whose storage layout is selected by a policy, for example
+//     Deque<Message, Segmented_layout> ingest_queue;
+template <typename Type, typename Layout = Contiguous_layout>
+using Deque = typename Layout::template deque<Type>;
+
+#endif
@@ -0,0 +1,142 @@
+#ifndef INDEX_ITERATOR_H
+#define INDEX_ITERATOR_H
+
+#include <cstddef>
+#include <iterator>
+#include <type_traits>
+
+// A random-access iterator over any deque with an unchecked operator[], front to back
+// It holds the deque and the index of its element, so it works with whatever layout the
+// deque uses; Segmented_deque and Small_deque use it for their iterators
+//
+// Container is the deque type, const-qualified for a const_iterator, and Value is the
+// element type, also const-qualified for a const_iterator
+// Any push, pop or clear() may invalidate it
+template <typename Container, typename Value>
+class Index_iterator {
+	public:
+		typedef std::random_access_iterator_tag iterator_category;
+		typedef typename std::remove_const<Value>::type value_type;
+		typedef std::ptrdiff_t difference_type;
+		typedef Value *pointer;
+		typedef Value &reference;
+
+		Index_iterator():
+		deque( nullptr ), k( 0 ) {
+			// empty constructor
+		}
+
+		Index_iterator( Container *d, int n ):
+		deque( d ), k( n ) {
+			// empty constructor
+		}
+
+		// An iterator converts to a const_iterator
+		template <typename Other_container, typename Other>
+		Index_iterator( Index_iterator<Other_container, Other> const &other,
+		                typename std::enable_if<std::is_convertible<Other_container *, Container *>::value>::type * = nullptr ):
+		deque( other.deque ), k( other.k ) {
+			// empty constructor
+		}
+
+		reference operator*() const {
+		    return (*deque)[k];
+		}
+
+		pointer operator->() const {
+		    return &(*deque)[k];
+		}
+
+		reference operator[]( difference_type n ) const {
+		    return (*deque)[k + static_cast<int>( n )];
+		}
+
+		Index_iterator &operator++() {
+		    ++k;
+		    return *this;
+		}
+
+		Index_iterator operator++( int ) {
+		    Index_iterator previous( *this );
+		    ++k;
+		    return previous;
+		}
+
+		Index_iterator &operator--() {
+		    --k;
+		    return *this;
+		}
+
+		Index_iterator operator--( int ) {
+		    Index_iterator previous( *this );
+		    --k;
+		    return previous;
+		}
+
+		Index_iterator &operator+=( difference_type n ) {
+		    k += static_cast<int>( n );
+		    return *this;
+		}
+
+		Index_iterator &operator-=( difference_type n ) {
+		    k -= static_cast<int>( n );
+		    return *this;
+		}
+
+		Index_iterator operator+( difference_type n ) const {
+		    return Index_iterator( deque, k + static_cast<int>( n ) );
+		}
+
+		friend Index_iterator operator+( difference_type n, Index_iterator const &it ) {
+		    return it + n;
+		}
+
+		Index_iterator operator-( difference_type n ) const {
+		    return Index_iterator( deque, k - static_cast<int>( n ) );
+		}
+
+		// Iterators and const_iterators over the same deque can be mixed in differences and comparisons
+		template <typename Other_container, typename Other>
+		difference_type operator-( Index_iterator<Other_container, Other> const &other ) const {
+		    return k - other.k;
+		}
+
+		template <typename Other_container, typename Other>
+		bool operator==( Index_iterator<Other_container, Other> const &other ) const {
+		    return deque == other.deque && k == other.k;
+		}
+
+		template <typename Other_container, typename Other>
+		bool operator!=( Index_iterator<Other_container, Other> const &other ) const {
+		    return !(*this == other);
+		}
+
+		template <typename Other_container, typename Other>
+		bool operator<( Index_iterator<Other_container, Other> const &other ) const {
+		    return k < other.k;
+		}
+
+		template <typename Other_container, typename Other>
+		bool operator>( Index_iterator<Other_container, Other> const &other ) const {
+		    return k > other.k;
+		}
+
+		template <typename Other_container, typename Other>
+		bool operator<=( Index_iterator<Other_container, Other> const &other ) const {
+		    return k <= other.k;
+		}
+
+		template <typename Other_container, typename Other>
+		bool operator>=( Index_iterator<Other_container, Other> const &other ) const {
+		    return k >= other.k;
+		}
+
+	private:
+		Container *deque;
+		int k;
+
+		template <typename C, typename V>
+		friend class Index_iterator;
+};
+
+#endif
@@ -0,0 +1,216 @@
+#ifndef MPMC_QUEUE_H
+#define MPMC_QUEUE_H
+
+#include <atomic>
+#include <cstddef>
+#include <new>
+#include <type_traits>
+#include <utility>
+
+// A bounded lock-free queue for any number of producer and consumer threads
+//
+// The objects sit in a circular array of 2^k cells indexed by unbounded counters, as in
+// Spsc_queue, but each cell also carries a sequence number that says whose turn it is:
+// cell i is free for the producer claiming position p when its sequence is p, and holds
+// an object for the consumer claiming position p when its sequence is p + 1
+// A thread claims a position with a compare-and-swap on the shared counter and then owns
+// that cell outright, so producers and consumers only contend on their own counter
+// (D. Vyukov's bounded MPMC queue)
+template <typename Type>
+class Mpmc_queue {
+	public:
+		Mpmc_queue( int = 1024 );
+		~Mpmc_queue();
+
+		int size() const;
+		bool empty() const;
+		int capacity() const;
+
+		bool push_back( Type const & );
+		bool push_back( Type && );
+		bool pop_front( Type & );
+
+	private:
+		static const int CACHE_LINE = 64;
+
+		class Cell {
+			public:
+				std::atomic<std::size_t> sequence;
+				typename std::aligned_storage<sizeof( Type ), alignof( Type )>::type storage;
+
+				Type &object() {
+				    return *reinterpret_cast<Type *>( &storage );
+				}
+		};
+
+		// The producers' and the consumers' counters, each on its own cache line
+		std::atomic<std::size_t> back;
+		char back_padding[CACHE_LINE - sizeof( std::atomic<std::size_t> )];
+		std::atomic<std::size_t> front;
+		char front_padding[CACHE_LINE - sizeof( std::atomic<std::size_t> )];
+
+		std::size_t mask;
+		Cell *cells;
+
+		template <typename Arg>
+		bool emplace_back( Arg && );
+
+		// The queue is shared by address between threads and is never copied
+		Mpmc_queue( Mpmc_queue const & );
+		Mpmc_queue &operator=( Mpmc_queue const & );
+};
+
+/////////////////////////////////////////////////////////////////////////
+//                   Constructors and Destructors                      //
+/////////////////////////////////////////////////////////////////////////
+
+// Constructor
+// The capacity is n rounded up to a power of 2, and at least 2
+template <typename Type>
+Mpmc_queue<Type>::Mpmc_queue( int n ):
+back( 0 ),
+front( 0 ),
+mask( 0 ),
+cells( nullptr ) {
+    std::size_t queue_capacity = 2;
+
+    while ( queue_capacity < static_cast<std::size_t>( n ) ) {
+        queue_capacity *= 2;
+    }
+
+    mask = queue_capacity - 1;
+    cells = new Cell[queue_capacity];
+
+    for ( std::size_t i = 0; i < queue_capacity; ++i ) {
+        cells[i].sequence.store( i, std::memory_order_relaxed );
+    }
+}
+
+// Destructor
+// Destroys the objects still in the queue; no thread may be using it
+template <typename Type>
+Mpmc_queue<Type>::~Mpmc_queue() {
+    std::size_t b = back.load( std::memory_order_relaxed );
+
+    for ( std::size_t i = front.load( std::memory_order_relaxed ); i != b; ++i ) {
+        cells[i & mask].object().~Type();
+    }
+
+    delete [] cells;
+}
+
+/////////////////////////////////////////////////////////////////////////
+//                     Public Member Functions                         //
+/////////////////////////////////////////////////////////////////////////
+
+//ACCESSORS
+
+// Return the number of objects in the queue
+// With other threads using the queue this is only a snapshot, and it counts objects
+// whose push or pop is still in progress
+template <typename Type>
+int Mpmc_queue<Type>::size() const {
+    std::size_t f = front.load( std::memory_order_acquire );
+    std::size_t b = back.load( std::memory_order_acquire );
+
+    return (b > f) ? static_cast<int>( b - f ) : 0;
+}
+
+template <typename Type>
+bool Mpmc_queue<Type>::empty() const {
+    return size() == 0;
+}
+
+template <typename Type>
+int Mpmc_queue<Type>::capacity() const {
+    return static_cast<int>( mask + 1 );
+}
+
+//MUTATORS
+
+// Copy an object onto the back of the queue
+// Returns false, leaving the queue unchanged, if it is full
+template <typename Type>
+bool Mpmc_queue<Type>::push_back( Type const &obj ) {
+    return emplace_back( obj );
+}
+
+// Move an object onto the back of the queue
+// Returns false, leaving the queue and the object unchanged, if it is full
+template <typename Type>
+bool Mpmc_queue<Type>::push_back( Type &&obj ) {
+    return emplace_back( std::move( obj ) );
+}
+
+// Move the object at the front of the queue into obj and remove it
+// Returns false, leaving obj unchanged, if the queue is empty
+template <typename Type>
+bool Mpmc_queue<Type>::pop_front( Type &obj ) {
+    std::size_t position = front.load( std::memory_order_relaxed );
+    Cell *cell;
+
+    while ( true ) {
+        cell = &cells[position & mask];
+        std::size_t sequence = cell->sequence.load( std::memory_order_acquire );
+        std::ptrdiff_t difference = static_cast<std::ptrdiff_t>( sequence - (position + 1) );
+
+        if ( difference == 0 ) {
+            // The cell holds an object: claim it, unless another consumer got there first
+            if ( front.compare_exchange_weak( position, position + 1, std::memory_order_relaxed ) )
+                break;
+        } else if ( difference < 0 ) {
+            // The producer of this position has not finished, or not started: the queue is empty
+            return false;
+        } else {
+            // Another consumer has already taken this position
+            position = front.load( std::memory_order_relaxed );
+        }
+    }
+
+    obj = std::move( cell->object() );
+    cell->object().~Type();
+
+    // Hand the cell to the producer of the position one lap later
+    cell->sequence.store( position + mask + 1, std::memory_order_release );
+
+    return true;
+}
+
+/////////////////////////////////////////////////////////////////////////
+//                      Private member functions                       //
+/////////////////////////////////////////////////////////////////////////
+
+// Construct an object at the back of the queue from the argument, unless the queue is full
+template <typename Type>
+template <typename Arg>
+bool Mpmc_queue<Type>::emplace_back( Arg &&arg ) {
+    std::size_t position = back.load( std::memory_order_relaxed );
+    Cell *cell;
+
+    while ( true ) {
+        cell = &cells[position & mask];
+        std::size_t sequence = cell->sequence.load( std::memory_order_acquire );
+        std::ptrdiff_t difference = static_cast<std::ptrdiff_t>( sequence - position );
+
+        if ( difference == 0 ) {
+            // The cell is free: claim it, unless another producer got there first
+            if ( back.compare_exchange_weak( position, position + 1, std::memory_order_relaxed ) )
+                break;
+        } else if ( difference < 0 ) {
+            // The consumer from one lap earlier has not emptied the cell: the queue is full
+            return false;
+        } else {
+            // Another producer has already taken this position
+            position = back.load( std::memory_order_relaxed );
+        }
+    }
+
+    new ( &cell->object() ) Type( std::forward<Arg>( arg ) );
+
+    // Hand the cell to the consumer of this position
+    cell->sequence.store( position + 1, std::memory_order_release );
+
+    return true;
+}
+
+#endif
@@ -0,0 +1,273 @@
+// Throughput and latency benchmark for Spsc_queue and Mpmc_queue
+//
+// Compares both lock-free queues against a Resizable_deque behind one mutex, the
+// arrangement they replace for handing objects from one thread to another
+//
+// Throughput: producers push the integers 0, ..., n - 1 between them and consumers pop
+// until all n have been seen; one producer and one consumer for every queue, then two of
+// each for the queues that allow several
+// The batched Spsc_queue row moves the objects in batches of a given size
+//
+// Latency: two threads bounce one object back and forth through a pair of queues; half
+// of each round trip is one handoff, of which the median and 99th percentile are reported
+//
+// Build and run with, for example:
+//     g++ -std=c++17 -O2 -pthread Queue_benchmark.cpp -o queue_benchmark
+//     ./queue_benchmark [objects] [queue capacity] [batch size] [round trips]
+
+#include <algorithm>
+#include <atomic>
+#include <chrono>
+#include <cstdlib>
+#include <iostream>
+#include <mutex>
+#include <thread>
+#include <vector>
+#include "Resizable_deque.h"
+#include "Spsc_queue.h"
+#include "Mpmc_queue.h"
+
+// A Resizable_deque behind a single mutex, the arrangement being replaced
+// It grows as needed, so a push never fails
+class Locked_queue {
+	public:
+		Locked_queue( int n ):
+		queue( n ) {
+			// empty constructor
+		}
+
+		bool push_back( long long obj ) {
+		    std::lock_guard<std::mutex> lock( queue_mutex );
+		    queue.push_back( obj );
+		    return true;
+		}
+
+		bool pop_front( long long &obj ) {
+		    std::lock_guard<std::mutex> lock( queue_mutex );
+
+		    if ( queue.empty() )
+		        return false;
+
+		    obj = queue.front();
+		    queue.pop_front();
+		    return true;
+		}
+
+	private:
+		std::mutex queue_mutex;
+		Resizable_deque<long long> queue;
+};
+
+// Push n objects through the queue from the given numbers of producer and consumer threads
+// Returns the throughput in millions of objects per second
+template <typename Queue>
+double run_throughput( Queue &queue, int producers, int consumers, long long n ) {
+    std::vector<std::thread> threads;
+    std::atomic<long long> consumed( 0 );
+    std::atomic<long long> checksum( 0 );
+    auto start = std::chrono::steady_clock::now();
+
+    for ( int p = 0; p < producers; ++p ) {
+        threads.emplace_back( [&queue, p, producers, n]() {
+            for ( long long i = p; i < n; i += producers ) {
+                while ( !queue.push_back( i ) ) {
+                    std::this_thread::yield();
+                }
+            }
+        } );
+    }
+
+    for ( int c = 0; c < consumers; ++c ) {
+        threads.emplace_back( [&queue, &consumed, &checksum, n]() {
+            long long sum = 0;
+            long long obj;
+
+            while ( consumed.load( std::memory_order_relaxed ) < n ) {
+                if ( queue.pop_front( obj ) ) {
+                    sum += obj;
+                    consumed.fetch_add( 1, std::memory_order_relaxed );
+                } else {
+                    std::this_thread::yield();
+                }
+            }
+
+            checksum.fetch_add( sum );
+        } );
+    }
+
+    for ( std::thread &thread : threads ) {
+        thread.join();
+    }
+
+    std::chrono::duration<double> elapsed = std::chrono::steady_clock::now() - start;
+
+    if ( checksum.load() != n * (n - 1) / 2 )
+        std::cout << "checksum mismatch" << std::endl;
+
+    return n / elapsed.count() / 1e6;
+}
+
+// As run_throughput(), for one producer and one consumer moving batches of the given size
+double run_batched_throughput( Spsc_queue<long long> &queue, long long n, int batch ) {
+    long long consumed_sum = 0;
+    auto start = std::chrono::steady_clock::now();
+
+    std::thread producer( [&queue, n, batch]() {
+        std::vector<long long> objs( batch );
+
+        for ( long long i = 0; i < n; ) {
+            int count = static_cast<int>( std::min<long long>( batch, n - i ) );
+
+            for ( int k = 0; k < count; ++k ) {
+                objs[k] = i + k;
+            }
+
+            int pushed = 0;
+
+            while ( pushed < count ) {
+                int now = queue.push_back( objs.data() + pushed, count - pushed );
+
+                if ( now == 0 )
+                    std::this_thread::yield();
+
+                pushed += now;
+            }
+
+            i += count;
+        }
+    } );
+
+    std::thread consumer( [&queue, &consumed_sum, n, batch]() {
+        std::vector<long long> objs( batch );
+        long long sum = 0;
+
+        for ( long long seen = 0; seen < n; ) {
+            int popped = queue.pop_front( objs.data(), batch );
+
+            if ( popped == 0 )
+                std::this_thread::yield();
+
+            for ( int k = 0; k < popped; ++k ) {
+                sum += objs[k];
+            }
+
+            seen += popped;
+        }
+
+        consumed_sum = sum;
+    } );
+
+    producer.join();
+    consumer.join();
+
+    std::chrono::duration<double> elapsed = std::chrono::steady_clock::now() - start;
+
+    if ( consumed_sum != n * (n - 1) / 2 )
+        std::cout << "checksum mismatch" << std::endl;
+
+    return n / elapsed.count() / 1e6;
+}
+
+// Bounce one object between two threads through the pair of queues for the given number
+// of round trips
+// Prints the median and 99th percentile of half a round trip, in nanoseconds
+template <typename Queue>
+void run_latency( char const *name, Queue &there, Queue &back, int round_trips ) {
+    std::vector<double> handoffs( round_trips );
+
+    std::thread echo( [&there, &back, round_trips]() {
+        long long obj;
+
+        for ( int i = 0; i < round_trips; ++i ) {
+            while ( !there.pop_front( obj ) ) {
+                // spin: yielding would measure the scheduler
+            }
+
+            while ( !back.push_back( obj ) ) {
+                // spin
+            }
+        }
+    } );
+
+    long long obj;
+
+    for ( int i = 0; i < round_trips; ++i ) {
+        auto start = std::chrono::steady_clock::now();
+
+        while ( !there.push_back( i ) ) {
+            // spin
+        }
+
+        while ( !back.pop_front( obj ) ) {
+            // spin
+        }
+
+        std::chrono::duration<double, std::nano> elapsed = std::chrono::steady_clock::now() - start;
+        handoffs[i] = elapsed.count() / 2;
+    }
+
+    echo.join();
+
+    std::sort( handoffs.begin(), handoffs.end() );
+
+    std::cout << name << "  median " << handoffs[round_trips / 2]
+              << " ns  p99 " << handoffs[static_cast<int>( 0.99 * (round_trips - 1) )] << " ns" << std::endl;
+}
+
+int main( int argc, char **argv ) {
+    long long n = (argc > 1) ? std::atoll( argv[1] ) : 10000000;
+    int queue_capacity = (argc > 2) ? std::atoi( argv[2] ) : 4096;
+    int batch = (argc > 3) ? std::atoi( argv[3] ) : 64;
+    int round_trips = (argc > 4) ? std::atoi( argv[4] ) : 100000;
+
+    std::cout << "throughput (Mobjects/s)" << std::endl;
+
+    {
+        Locked_queue locked( queue_capacity );
+        std::cout << "mutex Resizable_deque  1P/1C  " << run_throughput( locked, 1, 1, n ) << std::endl;
+    }
+
+    {
+        Spsc_queue<long long> spsc( queue_capacity );
+        std::cout << "Spsc_queue             1P/1C  " << run_throughput( spsc, 1, 1, n ) << std::endl;
+    }
+
+    {
+        Spsc_queue<long long> spsc( queue_capacity );
+        std::cout << "Spsc_queue batch " << batch << "      1P/1C  " << run_batched_throughput( spsc, n, batch ) << std::endl;
+    }
+
+    {
+        Mpmc_queue<long long> mpmc( queue_capacity );
+        std::cout << "Mpmc_queue             1P/1C  " << run_throughput( mpmc, 1, 1, n ) << std::endl;
+    }
+
+    {
+        Locked_queue locked( queue_capacity );
+        std::cout << "mutex Resizable_deque  2P/2C  " << run_throughput( locked, 2, 2, n ) << std::endl;
+    }
+
+    {
+        Mpmc_queue<long long> mpmc( queue_capacity );
+        std::cout << "Mpmc_queue             2P/2C  " << run_throughput( mpmc, 2, 2, n ) << std::endl;
+    }
+
+    std::cout << std::endl << "handoff latency" << std::endl;
+
+    {
+        Locked_queue there( queue_capacity ), back( queue_capacity );
+        run_latency( "mutex Resizable_deque", there, back, round_trips );
+    }
+
+    {
+        Spsc_queue<long long> there( queue_capacity ), back( queue_capacity );
+        run_latency( "Spsc_queue           ", there, back, round_trips );
+    }
+
+    {
+        Mpmc_queue<long long> there( queue_capacity ), back( queue_capacity );
+        run_latency( "Mpmc_queue           ", there, back, round_trips );
+    }
+
+    return 0;
+}
@@ -1,11 +1,61 @@
 #ifndef DYNAMIC_DEQUE_H
 #define DYNAMIC_DEQUE_H
 
+#include <algorithm>
+#include <cstddef>
+#include <cstring>
+#include <iterator>
+#include <new>
+#include <type_traits>
+#include <utility>
 #include "Exception.h"
 
-template <typename Type>
+// Policies for Resizable_deque
+
+// The default: any capacity of at least 16, with the indices wrapped around by comparison
+// A full array grows by growth_factor, and a pop that leaves the deque only
+// 1/shrink_divisor full halves it; a shrink_divisor of 0 turns shrinking off
+// Other policies derive from this one and override the constants they change
+class Deque_policy {
+	public:
+		static const bool power_of_two = false;
+		static const int growth_factor = 2;
+		static const int shrink_divisor = 4;
+};
+
+// Capacities rounded up to powers of 2, so that the indices wrap around with a mask
+// and an empty deque needs no special case: push_front, push_back and the pops have
+// no branch other than the check for a full or empty array
+class Power_of_two_policy: public Deque_policy {
+	public:
+		static const bool power_of_two = true;
+};
+
+// A deque that never gives memory back until it is destroyed, for bursty traffic
+// that would otherwise grow and shrink the array over and over
+class No_shrink_policy: public Deque_policy {
+	public:
+		static const int shrink_divisor = 0;
+};
+
+template <typename Type, typename Policy = Deque_policy>
 class Resizable_deque {
+	static_assert( Policy::growth_factor >= 2, "The growth factor must be at least 2" );
+	static_assert( !Policy::power_of_two || (Policy::growth_factor & (Policy::growth_factor - 1)) == 0,
+	               "A power-of-two deque must grow by a power of 2" );
+	static_assert( Policy::shrink_divisor == 0 || Policy::shrink_divisor >= 2, "The shrink divisor must be 0 or at least 2" );
+
 	public:
+		template <typename Value>
+		class Ring_iterator;
+		typedef Ring_iterator<Type> iterator;
+		typedef Ring_iterator<Type const> const_iterator;
+
+		template <typename Value>
+		class Segment;
+		typedef Segment<Type> span;
+		typedef Segment<Type const> const_span;
+
 		Resizable_deque( int = 16 );
 		Resizable_deque( Resizable_deque const & );
 		Resizable_deque( Resizable_deque && );
@@ -16,14 +66,28 @@ class Resizable_deque {
 		int size() const;
 		bool empty() const;
 		int capacity() const;
+		Type const &operator[]( int ) const;
+		const_iterator begin() const;
+		const_iterator end() const;
+		std::pair<const_span, const_span> as_spans() const;
 
+		Type &operator[]( int );
+		iterator begin();
+		iterator end();
+		std::pair<span, span> as_spans();
 		void swap( Resizable_deque & );
 		Resizable_deque &operator=( Resizable_deque const& );
 		Resizable_deque &operator=( Resizable_deque && );
 		void push_front( Type const & );
 		void push_back( Type const & );
+		template <typename Iterator, typename = typename std::iterator_traits<Iterator>::iterator_category>
+		void push_back( Iterator, Iterator );
 		void pop_front();
 		void pop_back();
+		void pop_front( int );
+		void pop_back( int );
+		void reserve( int );
+		void shrink_to_fit();
 		void clear();
 
 	private:
@@ -34,10 +98,181 @@ class Resizable_deque {
 		int array_capacity;
 		Type *array;
 
+		static Type *allocate( int );
+		static int capacity_for( int );
+		static int empty_back( int );
+		int next_index( int ) const;
+		int previous_index( int ) const;
+		int index_of( int ) const;
+		void destroy_all();
+		void move_elements( Type *, int );
+		int grown_capacity( int ) const;
+		void reallocate( int );
+		void shrink_after_pop( int );
+		template <typename Iterator>
+		void push_back_range( Iterator, Iterator, std::input_iterator_tag );
+		template <typename Iterator>
+		void push_back_range( Iterator, Iterator, std::forward_iterator_tag );
+
 	// Friends
 
-	template <typename T>
-	friend std::ostream &operator<<( std::ostream &, Resizable_deque<T> const & );
+	template <typename T, typename P>
+	friend std::ostream &operator<<( std::ostream &, Resizable_deque<T, P> const & );
+};
+
+// A random-access iterator over the elements, front to back
+// Value is Type, or Type const for a const_iterator
+// Any push, pop or clear() may invalidate it
+template <typename Type, typename Policy>
+template <typename Value>
+class Resizable_deque<Type, Policy>::Ring_iterator {
+	public:
+		typedef std::random_access_iterator_tag iterator_category;
+		typedef Type value_type;
+		typedef std::ptrdiff_t difference_type;
+		typedef Value *pointer;
+		typedef Value &reference;
+
+		Ring_iterator():
+		deque( nullptr ), k( 0 ) {
+			// empty constructor
+		}
+
+		Ring_iterator( Resizable_deque const *d, int n ):
+		deque( d ), k( n ) {
+			// empty constructor
+		}
+
+		// An iterator converts to a const_iterator
+		template <typename Other>
+		Ring_iterator( Ring_iterator<Other> const &other,
+		               typename std::enable_if<std::is_convertible<Other *, Value *>::value>::type * = nullptr ):
+		deque( other.deque ), k( other.k ) {
+			// empty constructor
+		}
+
+		reference operator*() const {
+		    return deque->array[deque->index_of( k )];
+		}
+
+		pointer operator->() const {
+		    return deque->array + deque->index_of( k );
+		}
+
+		reference operator[]( difference_type n ) const {
+		    return deque->array[deque->index_of( k + static_cast<int>( n ) )];
+		}
+
+		Ring_iterator &operator++() {
+		    ++k;
+		    return *this;
+		}
+
+		Ring_iterator operator++( int ) {
+		    Ring_iterator previous( *this );
+		    ++k;
+		    return previous;
+		}
+
+		Ring_iterator &operator--() {
+		    --k;
+		    return *this;
+		}
+
+		Ring_iterator operator--( int ) {
+		    Ring_iterator previous( *this );
+		    --k;
+		    return previous;
+		}
+
+		Ring_iterator &operator+=( difference_type n ) {
+		    k += static_cast<int>( n );
+		    return *this;
+		}
+
+		Ring_iterator &operator-=( difference_type n ) {
+		    k -= static_cast<int>( n );
+		    return *this;
+		}
+
+		Ring_iterator operator+( difference_type n ) const {
+		    return Ring_iterator( deque, k + static_cast<int>( n ) );
+		}
+
+		friend Ring_iterator operator+( difference_type n, Ring_iterator const &it ) {
+		    return it + n;
+		}
+
+		Ring_iterator operator-( difference_type n ) const {
+		    return Ring_iterator( deque, k - static_cast<int>( n ) );
+		}
+
+		// Iterators and const_iterators over the same deque can be mixed in differences and comparisons
+		template <typename Other>
+		difference_type operator-( Ring_iterator<Other> const &other ) const {
+		    return k - other.k;
+		}
+
+		template <typename Other>
+		bool operator==( Ring_iterator<Other> const &other ) const {
+		    return deque == other.deque && k == other.k;
+		}
+
+		template <typename Other>
+		bool operator!=( Ring_iterator<Other> const &other ) const {
+		    return !(*this == other);
+		}
+
+		template <typename Other>
+		bool operator<( Ring_iterator<Other> const &other ) const {
+		    return k < other.k;
+		}
+
+		template <typename Other>
+		bool operator>( Ring_iterator<Other> const &other ) const {
+		    return k > other.k;
+		}
+
+		template <typename Other>
+		bool operator<=( Ring_iterator<Other> const &other ) const {
+		    return k <= other.k;
+		}
+
+		template <typename Other>
+		bool operator>=( Ring_iterator<Other> const &other ) const {
+		    return k >= other.k;
+		}
+
+	private:
+		// The element is the k-th from the front, whatever index of the array holds it
+		Resizable_deque const *deque;
+		int k;
+
+		template <typename Other>
+		friend class Ring_iterator;
+};
+
+// A contiguous run of elements in the array, such as one of the two segments of the ring
+// Value is Type, or Type const for a const_span
+template <typename Type, typename Policy>
+template <typename Value>
+class Resizable_deque<Type, Policy>::Segment {
+	public:
+		Segment( Value *d = nullptr, int n = 0 ):
+		data( d ), size( n ) {
+			// empty constructor
+		}
+
+		Value *begin() const {
+		    return data;
+		}
+
+		Value *end() const {
+		    return data + size;
+		}
+
+		Value *data;
+		int size;
 };
 
 /////////////////////////////////////////////////////////////////////////
@@ -45,80 +280,77 @@ class Resizable_deque {
 /////////////////////////////////////////////////////////////////////////
 
 // Constructor
-template <typename Type>
-Resizable_deque<Type>::Resizable_deque( int n ):
+template <typename Type, typename Policy>
+Resizable_deque<Type, Policy>::Resizable_deque( int n ):
 ifront( 0 ),
-iback( -1 ),
+iback( empty_back( capacity_for( n ) ) ),
 deque_size( 0 ),
-initial_array_capacity( std::max(n, 16) ),          //sets the deque capacity at a minimum of 16
-array_capacity( std::max(n,16) ),
-array( new Type[array_capacity] )
+initial_array_capacity( capacity_for( n ) ),          //sets the deque capacity at a minimum of 16
+array_capacity( capacity_for( n ) ),
+array( allocate( array_capacity ) )
 {
-
+    //The array is raw storage: an element is only constructed when it is pushed.
 }
 // Copy Constructor
-template <typename Type>
-Resizable_deque<Type>::Resizable_deque( Resizable_deque const &deque ):
+template <typename Type, typename Policy>
+Resizable_deque<Type, Policy>::Resizable_deque( Resizable_deque const &deque ):
 ifront( deque.ifront ),
 iback( deque.iback ),
 deque_size( deque.size() ),
 initial_array_capacity( deque.initial_array_capacity ),
 array_capacity( deque.capacity() ),
-array( new Type[array_capacity] )
+array( allocate( array_capacity ) )
 {
-    //Loop through the argument array such that only the values important values are copied
-    //instead of copying all the elements in the argument array.
-    //Must a while loop since the condition of the loop is that the iterator != iback + 1, which it
-    //does if ifront is right after iback in the argument array.
+    //Copy-construct only the elements of the argument deque, at the same indices.
+    //The size is used as the loop condition, since ifront is right after iback when the deque is full.
     int i = ifront;
-    do {
-        array[i] = deque.array[i];
-        ++i;
-        if(i == capacity())
-            i = 0;
-    } while(i != iback + 1);
+    for(int k = 0; k < size(); k++) {
+        new (array + i) Type(deque.array[i]);
+        i = next_index(i);
+    }
 }
 
 // Move Constructor
-template <typename Type>
-Resizable_deque<Type>::Resizable_deque( Resizable_deque &&deque ):
+template <typename Type, typename Policy>
+Resizable_deque<Type, Policy>::Resizable_deque( Resizable_deque &&deque ):
 ifront( 0 ),
-iback( -1 ),
+iback( empty_back( 16 ) ),
 deque_size( 0 ),
 initial_array_capacity( 16 ),
 array_capacity( 16 ),
-array( new Type[array_capacity] )
+array( allocate( array_capacity ) )
 {
     //Simply call the swap function to swap all member variables with the argument deque.
 	swap(deque);
 }
 // Destructor
-template <typename Type>
-Resizable_deque<Type>::~Resizable_deque() {
-	delete [] array;
+template <typename Type, typename Policy>
+Resizable_deque<Type, Policy>::~Resizable_deque() {
+	destroy_all();
+	::operator delete( array );
 }
 
 /////////////////////////////////////////////////////////////////////////
 //                     Public Member Functions                         //
 /////////////////////////////////////////////////////////////////////////
 
-template <typename Type>
-int Resizable_deque<Type>::size() const {
+template <typename Type, typename Policy>
+int Resizable_deque<Type, Policy>::size() const {
 	return deque_size;
 }
 
-template <typename Type>
-int Resizable_deque<Type>::capacity() const {
+template <typename Type, typename Policy>
+int Resizable_deque<Type, Policy>::capacity() const {
 	return array_capacity;
 }
 
-template <typename Type>
-bool Resizable_deque<Type>::empty() const {
+template <typename Type, typename Policy>
+bool Resizable_deque<Type, Policy>::empty() const {
 	return deque_size == 0;
 }
 
-template <typename  Type>
-Type Resizable_deque<Type>::front() const {
+template <typename Type, typename Policy>
+Type Resizable_deque<Type, Policy>::front() const {
     //Only returns the object at the front if there is at least one value in the array, otherwise throws an exception.
 	if(empty())
 		throw underflow();
@@ -126,17 +358,68 @@ Type Resizable_deque<Type>::front() const {
 	return array[ifront];
 }
 
-template <typename  Type>
-Type Resizable_deque<Type>::back() const {
+template <typename Type, typename Policy>
+Type Resizable_deque<Type, Policy>::back() const {
     //Only returns the object at the back if there is at least one value in the array, otherwise throws an exception.
     if(empty())
 		throw underflow();
 
 	return array[iback];
 }
+
+// Return the k-th element from the front, for 0 <= k < size()
+// Unlike front() and back(), the index is not checked, so that it can be used in inner loops
+template <typename Type, typename Policy>
+Type const &Resizable_deque<Type, Policy>::operator[]( int k ) const {
+    return array[index_of(k)];
+}
+
+template <typename Type, typename Policy>
+Type &Resizable_deque<Type, Policy>::operator[]( int k ) {
+    return array[index_of(k)];
+}
+
+template <typename Type, typename Policy>
+typename Resizable_deque<Type, Policy>::const_iterator Resizable_deque<Type, Policy>::begin() const {
+    return const_iterator(this, 0);
+}
+
+template <typename Type, typename Policy>
+typename Resizable_deque<Type, Policy>::const_iterator Resizable_deque<Type, Policy>::end() const {
+    return const_iterator(this, size());
+}
+
+template <typename Type, typename Policy>
+typename Resizable_deque<Type, Policy>::iterator Resizable_deque<Type, Policy>::begin() {
+    return iterator(this, 0);
+}
+
+template <typename Type, typename Policy>
+typename Resizable_deque<Type, Policy>::iterator Resizable_deque<Type, Policy>::end() {
+    return iterator(this, size());
+}
+
+// Return the elements as at most two contiguous segments of the array, front first
+// The second segment is empty unless the elements wrap around the end of the array,
+// so the pair can be handed to a gather write (writev, for example) without copying
+template <typename Type, typename Policy>
+std::pair<typename Resizable_deque<Type, Policy>::const_span, typename Resizable_deque<Type, Policy>::const_span>
+Resizable_deque<Type, Policy>::as_spans() const {
+    int first_segment = std::min(size(), capacity() - ifront);
+
+    return std::make_pair(const_span(array + ifront, first_segment), const_span(array, size() - first_segment));
+}
+
+template <typename Type, typename Policy>
+std::pair<typename Resizable_deque<Type, Policy>::span, typename Resizable_deque<Type, Policy>::span>
+Resizable_deque<Type, Policy>::as_spans() {
+    int first_segment = std::min(size(), capacity() - ifront);
+
+    return std::make_pair(span(array + ifront, first_segment), span(array, size() - first_segment));
+}
 //TODO
-template <typename Type>
-void Resizable_deque<Type>::swap( Resizable_deque<Type> &deque ) {
+template <typename Type, typename Policy>
+void Resizable_deque<Type, Policy>::swap( Resizable_deque<Type, Policy> &deque ) {
     //swap all member values with this deque and the argument deque
     std::swap(ifront, deque.ifront);
     std::swap(iback, deque.iback);
@@ -146,163 +429,363 @@ void Resizable_deque<Type>::swap( Resizable_deque<Type> &deque ) {
     std::swap(array, deque.array);
 }
 
-template <typename Type>
-Resizable_deque<Type> &Resizable_deque<Type>::operator=( Resizable_deque<Type> const &rhs ) {
-	Resizable_deque<Type> copy( rhs );
+template <typename Type, typename Policy>
+Resizable_deque<Type, Policy> &Resizable_deque<Type, Policy>::operator=( Resizable_deque<Type, Policy> const &rhs ) {
+	Resizable_deque<Type, Policy> copy( rhs );
 	swap( copy );
 
 	return *this;
 }
 
-template <typename Type>
-Resizable_deque<Type> &Resizable_deque<Type>::operator=( Resizable_deque<Type> &&rhs ) {
+template <typename Type, typename Policy>
+Resizable_deque<Type, Policy> &Resizable_deque<Type, Policy>::operator=( Resizable_deque<Type, Policy> &&rhs ) {
 	swap( rhs );
 
 	return *this;
 }
-template <typename Type>
-void Resizable_deque<Type>::push_front( Type const &obj ) {
+template <typename Type, typename Policy>
+void Resizable_deque<Type, Policy>::push_front( Type const &obj ) {
     //If the deque is not full, add the object at the front.
-    //Otherwise, create a new array of double the capacity and copy over the objects from the old array.
+    //Otherwise, create a new array of growth_factor times the capacity and copy over the objects from the old array.
     //The new array is indexed such that ifront is 0 and iback is the size of the old array.
     //Update the member variables, delete the old array, and set array to the new array.
+    //The new object is constructed before the old ones are moved, in case it refers to one of them.
     if(size() == capacity()){
-        Type * tempArray = new Type[capacity()*2];
-        tempArray[0] = obj;
-        for(int i = 0; i < size() ; i++ ){
-            tempArray[i+1] = array[ifront];
-            ++ifront;
-            if(ifront == capacity())
-                ifront = 0;
-        }
+        int new_capacity = grown_capacity(size() + 1);
+        Type * tempArray = allocate(new_capacity);
+        new (tempArray) Type(obj);
+        move_elements(tempArray, 1);
         ++deque_size;
         iback = size() - 1;                     //account for 0 indexing
         ifront = 0;
-        array_capacity = capacity()*2;
-        delete [] array;
-        array = tempArray;
+        array_capacity = new_capacity;
     }
     else {
         //Check if the element to be added will be the first. If it is the first, then iback must be updated
         //so that it is 0 instead of -1.
         //Otherwise, decrement ifront and insert the object at the index of ifront.
         //ifront is set to the max index if it is less than 0 when decremented.
-        if(iback < 0) {
+        //With a power-of-two capacity, iback of an empty deque is already just before ifront,
+        //so the first element needs no special case.
+        if(!Policy::power_of_two && iback < 0) {
             iback = 0;
-            array[ifront] = obj;
+            new (array + ifront) Type(obj);
         }
         else {
-            --ifront;
-            if (ifront < 0)
-                ifront = capacity() - 1;
-            array[ifront] = obj;
+            int i = previous_index(ifront);
+            new (array + i) Type(obj);
+            ifront = i;
         }
         ++deque_size;
     }
 }
-template <typename Type>
-void Resizable_deque<Type>::push_back( Type const &obj ) {
+template <typename Type, typename Policy>
+void Resizable_deque<Type, Policy>::push_back( Type const &obj ) {
     //Similar to push_front in terms of logic and code except the object is added to the back of the queue.
     if(size() == capacity()){
-        Type * tempArray = new Type[capacity()*2];
-        tempArray[size()] = obj;
-        for(int i = 0; i < size() ; i++ ){
-            tempArray[i] = array[ifront];
-            ++ifront;
-            if(ifront == capacity())
-                ifront = 0;
-        }
+        int new_capacity = grown_capacity(size() + 1);
+        Type * tempArray = allocate(new_capacity);
+        new (tempArray + size()) Type(obj);
+        move_elements(tempArray, 0);
         ++deque_size;
         iback = size() - 1;
         ifront = 0;
-        array_capacity = capacity()*2;
-        delete [] array;
-        array = tempArray;
+        array_capacity = new_capacity;
     }
     else {
-        if(iback < 0) {
+        if(!Policy::power_of_two && iback < 0) {
             iback = 0;
-            array[ifront] = obj;
+            new (array + ifront) Type(obj);
         }
         else {
-            ++iback;
-            if (iback == capacity())
-                iback = 0;
-            array[iback] = obj;
+            int i = next_index(iback);
+            new (array + i) Type(obj);
+            iback = i;
         }
         ++deque_size;
     }
 }
-template <typename Type>
-void Resizable_deque<Type>::pop_front() {
+
+// Insert copies of the objects in [first, last) at the back, in order
+// When the length of the range is known the array grows at most once, and the objects
+// are copied straight into their slots; the range must not refer into this deque
+template <typename Type, typename Policy>
+template <typename Iterator, typename>
+void Resizable_deque<Type, Policy>::push_back( Iterator first, Iterator last ) {
+    push_back_range(first, last, typename std::iterator_traits<Iterator>::iterator_category());
+}
+
+template <typename Type, typename Policy>
+void Resizable_deque<Type, Policy>::pop_front() {
     //If empty throw an exception.
     //If not, point ifront to the next object and decrease the size by 1.
     //If ifront is at max index, set it to 0.
-    //If the new size is a quarter of the current capacity and bigger than the initial capacity,
+    //If the new size is 1/shrink_divisor of the current capacity and bigger than the initial capacity,
     //then make a new array of half the size, copy over the elements, update the member variables,
     //delete the old array, and set array to the new array.
     if(empty())
         throw underflow();
-    ++ifront;
+    array[ifront].~Type();
+    ifront = next_index(ifront);
     --deque_size;
-    if(ifront == capacity())
-        ifront = 0;
-    if(size() == capacity()/4 && capacity() > initial_array_capacity){
-        Type * tempArray = new Type[capacity()/2];
-        for(int i = 0; i < size() ; i++){
-            tempArray[i] = array[ifront];
-            ++ifront;
-            if(ifront == capacity())
-                ifront = 0;
-        }
-        array_capacity = capacity() / 2;
-        ifront = 0;
-        iback = size() - 1;
-        delete [] array;
-        array = tempArray;
-    }
+    shrink_after_pop(1);
 }
-template <typename Type>
-void Resizable_deque<Type>::pop_back() {
+template <typename Type, typename Policy>
+void Resizable_deque<Type, Policy>::pop_back() {
     //Similar to pop_front in terms of logic and code, except the object at the back is popped.
     if(empty())
         throw underflow();
-    --iback;
+    array[iback].~Type();
+    iback = previous_index(iback);
     --deque_size;
-    if(iback < 0)
-        iback = capacity() - 1;
-    if(size() == capacity()/4 && capacity() > initial_array_capacity){
-        Type * tempArray = new Type[capacity()/2];
-        for(int i = 0; i < size() ; i++){
-            tempArray[i] = array[ifront];
-            ++ifront;
-            if(ifront == capacity())
-                ifront = 0;
-        }
-        array_capacity = capacity() / 2;
-        ifront = 0;
-        iback = size() - 1;
-        delete [] array;
-        array = tempArray;
-    }}
-template <typename Type>
-void Resizable_deque<Type>::clear() {
-    //Set all member variables to the default value as if no object are present in the deque.
-    //Also revert to the initial array capacity if it's not current capacity.
+    shrink_after_pop(1);
+}
+
+// Remove the n objects at the front, shrinking the array at most once
+template <typename Type, typename Policy>
+void Resizable_deque<Type, Policy>::pop_front( int n ) {
+    if(n < 0)
+        throw illegal_argument();
+    if(n > size())
+        throw underflow();
+    if(n == 0)
+        return;
+
+    if(!std::is_trivially_destructible<Type>::value) {
+        for(int k = 0; k < n; k++)
+            array[index_of(k)].~Type();
+    }
+
+    ifront = index_of(n);
+    deque_size -= n;
+    shrink_after_pop(n);
+}
+
+// Remove the n objects at the back, shrinking the array at most once
+template <typename Type, typename Policy>
+void Resizable_deque<Type, Policy>::pop_back( int n ) {
+    if(n < 0)
+        throw illegal_argument();
+    if(n > size())
+        throw underflow();
+    if(n == 0)
+        return;
+
+    if(!std::is_trivially_destructible<Type>::value) {
+        for(int k = size() - n; k < size(); k++)
+            array[index_of(k)].~Type();
+    }
+
+    //iback moves to just before the new back, which is just before ifront if the deque is now empty
+    iback = (size() == n) ? previous_index(ifront) : index_of(size() - n - 1);
+    deque_size -= n;
+    shrink_after_pop(n);
+}
+
+// Make room for at least n objects, so that the deque can grow to n without reallocating
+template <typename Type, typename Policy>
+void Resizable_deque<Type, Policy>::reserve( int n ) {
+    if(n > capacity())
+        reallocate(capacity_for(n));
+}
+
+// Reduce the capacity to the smallest the policy allows for the current size
+template <typename Type, typename Policy>
+void Resizable_deque<Type, Policy>::shrink_to_fit() {
+    int new_capacity = capacity_for(size());
+
+    if(new_capacity < capacity())
+        reallocate(new_capacity);
+}
+template <typename Type, typename Policy>
+void Resizable_deque<Type, Policy>::clear() {
+    //Destroy the elements and set all member variables to the default value as if no object are present in the deque.
+    //Also revert to the initial array capacity if it's not current capacity, unless the policy never shrinks.
+    destroy_all();
     ifront = 0;
-    iback = -1;
+    iback = empty_back(Policy::shrink_divisor == 0 ? array_capacity : initial_array_capacity);
     deque_size = 0;
-    if(array_capacity != initial_array_capacity) {
+    if(Policy::shrink_divisor != 0 && array_capacity != initial_array_capacity) {
         array_capacity = initial_array_capacity;
-        delete [] array;
-        array = new Type[initial_array_capacity];
+        ::operator delete(array);
+        array = allocate(initial_array_capacity);
     }
 }
 /////////////////////////////////////////////////////////////////////////
 //                      Private member functions                       //
 /////////////////////////////////////////////////////////////////////////
 
-// Enter any private member functios (helper functions) here
+// Allocate uninitialized storage for n objects
+template <typename Type, typename Policy>
+Type *Resizable_deque<Type, Policy>::allocate( int n ) {
+    return static_cast<Type *>(::operator new(n * sizeof(Type)));
+}
+
+// Return the smallest capacity the policy allows for n objects:
+// at least 16, and rounded up to a power of 2 if the policy asks for it
+template <typename Type, typename Policy>
+int Resizable_deque<Type, Policy>::capacity_for( int n ) {
+    int deque_capacity = std::max(n, 16);
+
+    if(Policy::power_of_two) {
+        int power = 16;
+        while(power < deque_capacity)
+            power *= 2;
+        deque_capacity = power;
+    }
+
+    return deque_capacity;
+}
+
+// Return iback for an empty deque with the given capacity and ifront 0
+// A power-of-two deque keeps iback just before ifront, so that pushing at either end
+// needs no special case; otherwise -1 marks a deque that has never held an element
+template <typename Type, typename Policy>
+int Resizable_deque<Type, Policy>::empty_back( int deque_capacity ) {
+    return Policy::power_of_two ? deque_capacity - 1 : -1;
+}
+
+// Return the index after i, wrapping around the end of the array
+template <typename Type, typename Policy>
+int Resizable_deque<Type, Policy>::next_index( int i ) const {
+    if(Policy::power_of_two)
+        return (i + 1) & (array_capacity - 1);
+
+    ++i;
+    if(i == array_capacity)
+        i = 0;
+    return i;
+}
+
+// Return the index before i, wrapping around the start of the array
+template <typename Type, typename Policy>
+int Resizable_deque<Type, Policy>::previous_index( int i ) const {
+    if(Policy::power_of_two)
+        return (i + array_capacity - 1) & (array_capacity - 1);
+
+    --i;
+    if(i < 0)
+        i = array_capacity - 1;
+    return i;
+}
+
+// Return the index of the array holding the k-th element from the front
+template <typename Type, typename Policy>
+int Resizable_deque<Type, Policy>::index_of( int k ) const {
+    if(Policy::power_of_two)
+        return (ifront + k) & (array_capacity - 1);
+
+    int i = ifront + k;
+    if(i >= array_capacity)
+        i -= array_capacity;
+    return i;
+}
+
+// Destroy every element, leaving the indices unchanged
+template <typename Type, typename Policy>
+void Resizable_deque<Type, Policy>::destroy_all() {
+    //Trivially destructible elements need no destruction, so the loop is skipped for them.
+    if(std::is_trivially_destructible<Type>::value)
+        return;
+
+    int i = ifront;
+    for(int k = 0; k < size(); k++) {
+        array[i].~Type();
+        i = next_index(i);
+    }
+}
+
+// Move the elements, front first, into destination starting at index start,
+// then free the old array and make destination the array
+// The indices are left for the caller to update
+template <typename Type, typename Policy>
+void Resizable_deque<Type, Policy>::move_elements( Type *destination, int start ) {
+    //Trivially copyable elements are copied with at most two memcpy calls, one for each
+    //contiguous segment of the ring, instead of being moved one at a time.
+    if(std::is_trivially_copyable<Type>::value) {
+        int first_segment = std::min(size(), capacity() - ifront);
+        std::memcpy(static_cast<void *>(destination + start), array + ifront, first_segment * sizeof(Type));
+        std::memcpy(static_cast<void *>(destination + start + first_segment), array, (size() - first_segment) * sizeof(Type));
+    }
+    else {
+        int i = ifront;
+        for(int k = 0; k < size(); k++) {
+            new (destination + start + k) Type(std::move(array[i]));
+            array[i].~Type();
+            i = next_index(i);
+        }
+    }
+
+    ::operator delete(array);
+    array = destination;
+}
+
+// Return the capacity after growing by the policy's factor until n objects fit
+template <typename Type, typename Policy>
+int Resizable_deque<Type, Policy>::grown_capacity( int n ) const {
+    int new_capacity = capacity();
+
+    while(new_capacity < n)
+        new_capacity *= Policy::growth_factor;
+
+    return new_capacity;
+}
+
+// Move the elements to the start of a new array of the given capacity, which must hold them all
+template <typename Type, typename Policy>
+void Resizable_deque<Type, Policy>::reallocate( int new_capacity ) {
+    move_elements(allocate(new_capacity), 0);
+    array_capacity = new_capacity;
+    ifront = 0;
+    iback = empty() ? empty_back(new_capacity) : size() - 1;
+}
+
+// Halve the array, repeatedly if need be, after a pop of n objects left it at most 1/shrink_divisor full
+// Only a pop that crosses that threshold shrinks the array, so capacity set aside with
+// reserve() is not given back before the deque has been filled past it
+template <typename Type, typename Policy>
+void Resizable_deque<Type, Policy>::shrink_after_pop( int n ) {
+    if(Policy::shrink_divisor == 0 || capacity() <= initial_array_capacity)
+        return;
+
+    //The divisor is never 0 here; the guard only keeps the compiler from warning about it.
+    int divisor = (Policy::shrink_divisor == 0) ? 1 : Policy::shrink_divisor;
+    int threshold = capacity() / divisor;
+    if(size() > threshold || size() + n <= threshold)
+        return;
+
+    int new_capacity = capacity();
+    while(new_capacity / 2 >= initial_array_capacity && size() <= new_capacity / divisor)
+        new_capacity /= 2;
+
+    if(new_capacity < capacity())
+        reallocate(new_capacity);
+}
+
+// Push the objects of an input range one at a time, since its length is not known in advance
+template <typename Type, typename Policy>
+template <typename Iterator>
+void Resizable_deque<Type, Policy>::push_back_range( Iterator first, Iterator last, std::input_iterator_tag ) {
+    for(; first != last; ++first)
+        push_back(*first);
+}
+
+// Grow the array once for the whole range, then copy-construct each object in its slot
+template <typename Type, typename Policy>
+template <typename Iterator>
+void Resizable_deque<Type, Policy>::push_back_range( Iterator first, Iterator last, std::forward_iterator_tag ) {
+    int n = static_cast<int>(std::distance(first, last));
+
+    if(size() + n > capacity())
+        reallocate(grown_capacity(size() + n));
+
+    for(; first != last; ++first) {
+        int i = index_of(size());
+        new (array + i) Type(*first);
+        iback = i;
+        ++deque_size;
+    }
+}
 
 
 /////////////////////////////////////////////////////////////////////////
@@ -311,8 +794,8 @@ void Resizable_deque<Type>::clear() {
 
 // You can modify this function however you want:  it will not be tested
 
-template <typename T>
-std::ostream &operator<<( std::ostream &out, Resizable_deque<T> const &list ) {
+template <typename T, typename P>
+std::ostream &operator<<( std::ostream &out, Resizable_deque<T, P> const &list ) {
 	out << "not yet implemented";
 
 	return out;
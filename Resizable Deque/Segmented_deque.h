@@ -0,0 +1,523 @@
+#ifndef SEGMENTED_DEQUE_H
+#define SEGMENTED_DEQUE_H
+
+#include <algorithm>
+#include <iterator>
+#include <new>
+#include <utility>
+#include "Exception.h"
+#include "Index_iterator.h"
+
+// A deque stored in fixed-size blocks of Block_size elements, reached through a central map
+// of block pointers, the way std::deque is laid out
+// It has the interface that Deque.h lists as common to all layouts
+//
+// Growing never moves an element: a push that runs off the last block allocates one more
+// block, and only the map, which holds one pointer per block, is ever reallocated
+// References to elements therefore stay valid across pushes and pops at either end
+// Blocks are freed as soon as they are emptied by a pop
+template <typename Type, int Block_size = (sizeof( Type ) * 16 < 4096) ? static_cast<int>( 4096 / sizeof( Type ) ) : 16>
+class Segmented_deque {
+	public:
+		typedef Index_iterator<Segmented_deque, Type> iterator;
+		typedef Index_iterator<Segmented_deque const, Type const> const_iterator;
+
+		Segmented_deque( int = 16 );
+		Segmented_deque( Segmented_deque const & );
+		Segmented_deque( Segmented_deque && );
+		~Segmented_deque();
+
+		Type front() const;
+		Type back() const;
+		int size() const;
+		bool empty() const;
+		int capacity() const;
+		Type const &operator[]( int ) const;
+		const_iterator begin() const;
+		const_iterator end() const;
+
+		Type &operator[]( int );
+		iterator begin();
+		iterator end();
+		void swap( Segmented_deque & );
+		Segmented_deque &operator=( Segmented_deque const& );
+		Segmented_deque &operator=( Segmented_deque && );
+		void push_front( Type const & );
+		void push_back( Type const & );
+		template <typename Iterator, typename = typename std::iterator_traits<Iterator>::iterator_category>
+		void push_back( Iterator, Iterator );
+		void pop_front();
+		void pop_back();
+		void pop_front( int );
+		void pop_back( int );
+		void reserve( int );
+		void shrink_to_fit();
+		void clear();
+
+	private:
+		// The element at index i of the deque is at position start + i, which is slot
+		// (start + i) % Block_size of block map[(start + i) / Block_size]
+		Type **map;
+		int map_capacity;
+		int start;
+		int deque_size;
+		int block_count;
+
+		Type &at_position( int ) const;
+		void allocate_block( int );
+		void free_block( int );
+		int used_blocks() const;
+		void reserve_map( bool, int );
+		void move_map( int, int );
+		template <typename Iterator>
+		void push_back_range( Iterator, Iterator, std::input_iterator_tag );
+		template <typename Iterator>
+		void push_back_range( Iterator, Iterator, std::forward_iterator_tag );
+
+	// Friends
+
+	template <typename T, int B>
+	friend std::ostream &operator<<( std::ostream &, Segmented_deque<T, B> const & );
+};
+
+/////////////////////////////////////////////////////////////////////////
+//                   Constructors and Destructors                      //
+/////////////////////////////////////////////////////////////////////////
+
+// Constructor
+// The map starts with room for about n elements; no block is allocated until the first push
+template <typename Type, int Block_size>
+Segmented_deque<Type, Block_size>::Segmented_deque( int n ):
+map( nullptr ),
+map_capacity( std::max( 8, 2*(n / Block_size + 1) ) ),
+start( (map_capacity / 2) * Block_size ),
+deque_size( 0 ),
+block_count( 0 ) {
+    map = new Type *[map_capacity]();
+}
+
+// Copy Constructor
+template <typename Type, int Block_size>
+Segmented_deque<Type, Block_size>::Segmented_deque( Segmented_deque const &deque ):
+map( nullptr ),
+map_capacity( std::max( 8, 2*(deque.size() / Block_size + 1) ) ),
+start( (map_capacity / 2) * Block_size ),
+deque_size( 0 ),
+block_count( 0 ) {
+    map = new Type *[map_capacity]();
+
+    for ( int i = 0; i < deque.size(); ++i ) {
+        push_back( deque.at_position( deque.start + i ) );
+    }
+}
+
+// Move Constructor
+template <typename Type, int Block_size>
+Segmented_deque<Type, Block_size>::Segmented_deque( Segmented_deque &&deque ):
+map( new Type *[8]() ),
+map_capacity( 8 ),
+start( 4 * Block_size ),
+deque_size( 0 ),
+block_count( 0 ) {
+	swap( deque );
+}
+
+// Destructor
+template <typename Type, int Block_size>
+Segmented_deque<Type, Block_size>::~Segmented_deque() {
+	clear();
+	delete [] map;
+}
+
+/////////////////////////////////////////////////////////////////////////
+//                     Public Member Functions                         //
+/////////////////////////////////////////////////////////////////////////
+
+template <typename Type, int Block_size>
+int Segmented_deque<Type, Block_size>::size() const {
+	return deque_size;
+}
+
+// Return the number of elements the allocated blocks can hold
+template <typename Type, int Block_size>
+int Segmented_deque<Type, Block_size>::capacity() const {
+	return block_count * Block_size;
+}
+
+template <typename Type, int Block_size>
+bool Segmented_deque<Type, Block_size>::empty() const {
+	return deque_size == 0;
+}
+
+template <typename Type, int Block_size>
+Type Segmented_deque<Type, Block_size>::front() const {
+	if ( empty() )
+		throw underflow();
+
+	return at_position( start );
+}
+
+template <typename Type, int Block_size>
+Type Segmented_deque<Type, Block_size>::back() const {
+	if ( empty() )
+		throw underflow();
+
+	return at_position( start + deque_size - 1 );
+}
+
+// Return the k-th element from the front, for 0 <= k < size()
+// Unlike front() and back(), the index is not checked, so that it can be used in inner loops
+template <typename Type, int Block_size>
+Type const &Segmented_deque<Type, Block_size>::operator[]( int k ) const {
+	return at_position( start + k );
+}
+
+template <typename Type, int Block_size>
+Type &Segmented_deque<Type, Block_size>::operator[]( int k ) {
+	return at_position( start + k );
+}
+
+template <typename Type, int Block_size>
+typename Segmented_deque<Type, Block_size>::const_iterator Segmented_deque<Type, Block_size>::begin() const {
+	return const_iterator( this, 0 );
+}
+
+template <typename Type, int Block_size>
+typename Segmented_deque<Type, Block_size>::const_iterator Segmented_deque<Type, Block_size>::end() const {
+	return const_iterator( this, deque_size );
+}
+
+template <typename Type, int Block_size>
+typename Segmented_deque<Type, Block_size>::iterator Segmented_deque<Type, Block_size>::begin() {
+	return iterator( this, 0 );
+}
+
+template <typename Type, int Block_size>
+typename Segmented_deque<Type, Block_size>::iterator Segmented_deque<Type, Block_size>::end() {
+	return iterator( this, deque_size );
+}
+
+template <typename Type, int Block_size>
+void Segmented_deque<Type, Block_size>::swap( Segmented_deque &deque ) {
+    std::swap( map, deque.map );
+    std::swap( map_capacity, deque.map_capacity );
+    std::swap( start, deque.start );
+    std::swap( deque_size, deque.deque_size );
+    std::swap( block_count, deque.block_count );
+}
+
+template <typename Type, int Block_size>
+Segmented_deque<Type, Block_size> &Segmented_deque<Type, Block_size>::operator=( Segmented_deque const &rhs ) {
+	Segmented_deque copy( rhs );
+	swap( copy );
+
+	return *this;
+}
+
+template <typename Type, int Block_size>
+Segmented_deque<Type, Block_size> &Segmented_deque<Type, Block_size>::operator=( Segmented_deque &&rhs ) {
+	swap( rhs );
+
+	return *this;
+}
+
+// Insert an object at the front, allocating a block if the front one is full
+// An empty deque puts its first object at start either way, in the block that may have been kept
+template <typename Type, int Block_size>
+void Segmented_deque<Type, Block_size>::push_front( Type const &obj ) {
+    if ( empty() ) {
+        push_back( obj );
+        return;
+    }
+
+    if ( start == 0 )
+        reserve_map( true, 1 );
+
+    int position = start - 1;
+
+    if ( map[position / Block_size] == nullptr )
+        allocate_block( position / Block_size );
+
+    new ( &at_position( position ) ) Type( obj );
+    start = position;
+    ++deque_size;
+}
+
+// Insert an object at the back, allocating a block if the back one is full
+template <typename Type, int Block_size>
+void Segmented_deque<Type, Block_size>::push_back( Type const &obj ) {
+    if ( start + deque_size == map_capacity * Block_size )
+        reserve_map( false, 1 );
+
+    int position = start + deque_size;
+
+    if ( map[position / Block_size] == nullptr )
+        allocate_block( position / Block_size );
+
+    new ( &at_position( position ) ) Type( obj );
+    ++deque_size;
+}
+
+// Remove the object at the front, freeing its block if it was the last object in it
+template <typename Type, int Block_size>
+void Segmented_deque<Type, Block_size>::pop_front() {
+    if ( empty() )
+        throw underflow();
+
+    at_position( start ).~Type();
+    ++start;
+    --deque_size;
+
+    if ( start % Block_size == 0 )
+        free_block( start / Block_size - 1 );
+}
+
+// Remove the object at the back, freeing its block if it was the last object in it
+// The block holding the front position is kept, even when the deque becomes empty
+template <typename Type, int Block_size>
+void Segmented_deque<Type, Block_size>::pop_back() {
+    if ( empty() )
+        throw underflow();
+
+    int position = start + deque_size - 1;
+
+    at_position( position ).~Type();
+    --deque_size;
+
+    if ( position % Block_size == 0 && position / Block_size != start / Block_size )
+        free_block( position / Block_size );
+}
+
+// Insert copies of the objects in [first, last) at the back, in order
+// When the length of the range is known every block it needs is allocated first;
+// the range must not refer into this deque
+template <typename Type, int Block_size>
+template <typename Iterator, typename>
+void Segmented_deque<Type, Block_size>::push_back( Iterator first, Iterator last ) {
+    push_back_range( first, last, typename std::iterator_traits<Iterator>::iterator_category() );
+}
+
+// Remove the n objects at the front, freeing every block they emptied
+template <typename Type, int Block_size>
+void Segmented_deque<Type, Block_size>::pop_front( int n ) {
+    if ( n < 0 )
+        throw illegal_argument();
+
+    if ( n > deque_size )
+        throw underflow();
+
+    for ( int i = 0; i < n; ++i ) {
+        at_position( start + i ).~Type();
+    }
+
+    // As with pop_front(), a block is freed once its last slot has been popped
+    for ( int b = start / Block_size; b < (start + n) / Block_size; ++b ) {
+        free_block( b );
+    }
+
+    start += n;
+    deque_size -= n;
+}
+
+// Remove the n objects at the back, freeing every block they emptied
+// As with pop_back(), the block holding the front position is kept
+template <typename Type, int Block_size>
+void Segmented_deque<Type, Block_size>::pop_back( int n ) {
+    if ( n < 0 )
+        throw illegal_argument();
+
+    if ( n > deque_size )
+        throw underflow();
+
+    if ( n == 0 )
+        return;
+
+    int new_end = start + deque_size - n;
+    int last_block = (start + deque_size - 1) / Block_size;
+
+    for ( int position = new_end; position < start + deque_size; ++position ) {
+        at_position( position ).~Type();
+    }
+
+    // A block is freed once its first slot has been popped
+    for ( int b = std::max( (new_end + Block_size - 1) / Block_size, start / Block_size + 1 ); b <= last_block; ++b ) {
+        free_block( b );
+    }
+
+    deque_size -= n;
+}
+
+// Allocate every block needed for the deque to grow to n objects at the back, so that
+// pushing up to n objects at the back never allocates
+template <typename Type, int Block_size>
+void Segmented_deque<Type, Block_size>::reserve( int n ) {
+    if ( n <= deque_size )
+        return;
+
+    // Blocks needed from the front block on, against those the map has room for
+    int blocks = (start % Block_size + n + Block_size - 1) / Block_size;
+
+    if ( start / Block_size + blocks > map_capacity )
+        reserve_map( false, blocks - used_blocks() );
+
+    for ( int b = start / Block_size; b < start / Block_size + blocks; ++b ) {
+        if ( map[b] == nullptr )
+            allocate_block( b );
+    }
+}
+
+// Free the blocks past the back that reserve() allocated, and the block an empty deque
+// keeps, then shrink the map to twice the blocks in use
+template <typename Type, int Block_size>
+void Segmented_deque<Type, Block_size>::shrink_to_fit() {
+    if ( empty() ) {
+        clear();
+    } else {
+        for ( int b = (start + deque_size - 1) / Block_size + 1; b < map_capacity; ++b ) {
+            if ( map[b] != nullptr )
+                free_block( b );
+        }
+    }
+
+    int used = used_blocks();
+    int new_capacity = std::max( 8, 2*used );
+
+    if ( new_capacity < map_capacity )
+        move_map( new_capacity, (new_capacity - used) / 2 );
+}
+
+// Destroy every element and free every block, leaving the map in place
+template <typename Type, int Block_size>
+void Segmented_deque<Type, Block_size>::clear() {
+    for ( int i = 0; i < deque_size; ++i ) {
+        at_position( start + i ).~Type();
+    }
+
+    for ( int b = 0; b < map_capacity; ++b ) {
+        if ( map[b] != nullptr )
+            free_block( b );
+    }
+
+    deque_size = 0;
+    start = (map_capacity / 2) * Block_size;
+}
+
+/////////////////////////////////////////////////////////////////////////
+//                      Private member functions                       //
+/////////////////////////////////////////////////////////////////////////
+
+// Return the slot at a position, which must be in an allocated block
+template <typename Type, int Block_size>
+Type &Segmented_deque<Type, Block_size>::at_position( int position ) const {
+    return map[position / Block_size][position % Block_size];
+}
+
+// Allocate uninitialized storage for block b of the map
+template <typename Type, int Block_size>
+void Segmented_deque<Type, Block_size>::allocate_block( int b ) {
+    map[b] = static_cast<Type *>( ::operator new( Block_size * sizeof( Type ) ) );
+    ++block_count;
+}
+
+// Free block b of the map, whose elements must already have been destroyed
+template <typename Type, int Block_size>
+void Segmented_deque<Type, Block_size>::free_block( int b ) {
+    ::operator delete( map[b] );
+    map[b] = nullptr;
+    --block_count;
+}
+
+// Make room in the map for n more blocks at the front or at the back
+// The blocks in use are re-centred in the map, which is doubled first, as often as needed,
+// if they and the n new ones would fill more than half of it; a deque used as a queue drifts
+// towards the back of the map, and re-centring lets it reuse the same map instead of
+// growing it without bound
+// Only block pointers are copied, so no element moves
+template <typename Type, int Block_size>
+void Segmented_deque<Type, Block_size>::reserve_map( bool at_front, int n ) {
+    int used = used_blocks();
+    int new_capacity = map_capacity;
+
+    while ( 2*(used + n) > new_capacity ) {
+        new_capacity *= 2;
+    }
+
+    // Leave the free blocks on the side that is about to grow
+    int new_first = at_front ? std::max( (new_capacity - used) / 2, n ) : std::min( (new_capacity - used) / 2, new_capacity - used - n );
+
+    move_map( new_capacity, new_first );
+}
+
+// Return the number of map entries in use: from the front block to the back block, or to
+// the last block allocated past the back by reserve() if there is one
+// No block is allocated before the front block
+template <typename Type, int Block_size>
+int Segmented_deque<Type, Block_size>::used_blocks() const {
+    int first_block = start / Block_size;
+    int last_block = (deque_size == 0) ? first_block : (start + deque_size - 1) / Block_size;
+
+    // An empty deque whose last object was popped from the front may start just past the map
+    if ( last_block == map_capacity )
+        last_block--;
+
+    for ( int b = map_capacity - 1; b > last_block; --b ) {
+        if ( map[b] != nullptr )
+            return b - first_block + 1;
+    }
+
+    return last_block - first_block + 1;
+}
+
+// Replace the map by one of new_capacity pointers, with the used_blocks() entries from the
+// front block on starting at new_first
+template <typename Type, int Block_size>
+void Segmented_deque<Type, Block_size>::move_map( int new_capacity, int new_first ) {
+    int first_block = start / Block_size;
+    int used = used_blocks();
+    Type **new_map = new Type *[new_capacity]();
+
+    for ( int b = 0; b < used; ++b ) {
+        new_map[new_first + b] = map[first_block + b];
+    }
+
+    delete [] map;
+    map = new_map;
+    map_capacity = new_capacity;
+    start = new_first * Block_size + start % Block_size;
+}
+
+// Push the objects of an input range one at a time, since its length is not known in advance
+template <typename Type, int Block_size>
+template <typename Iterator>
+void Segmented_deque<Type, Block_size>::push_back_range( Iterator first, Iterator last, std::input_iterator_tag ) {
+    for ( ; first != last; ++first ) {
+        push_back( *first );
+    }
+}
+
+// Allocate the blocks for the whole range, then copy-construct each object in its slot
+template <typename Type, int Block_size>
+template <typename Iterator>
+void Segmented_deque<Type, Block_size>::push_back_range( Iterator first, Iterator last, std::forward_iterator_tag ) {
+    reserve( deque_size + static_cast<int>( std::distance( first, last ) ) );
+
+    for ( ; first != last; ++first ) {
+        new ( &at_position( start + deque_size ) ) Type( *first );
+        ++deque_size;
+    }
+}
+
+/////////////////////////////////////////////////////////////////////////
+//                               Friends                               //
+/////////////////////////////////////////////////////////////////////////
+
+template <typename T, int B>
+std::ostream &operator<<( std::ostream &out, Segmented_deque<T, B> const &deque ) {
+	for ( int i = 0; i < deque.size(); ++i ) {
+		out << deque.at_position( deque.start + i ) << ' ';
+	}
+
+	return out;
+}
+
+#endif
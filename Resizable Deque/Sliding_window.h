@@ -0,0 +1,296 @@
+#ifndef SLIDING_WINDOW_H
+#define SLIDING_WINDOW_H
+
+#include <algorithm>
+#include <functional>
+#include <iterator>
+#include <vector>
+#include "Exception.h"
+#include "Resizable_deque.h"
+
+// Aggregates over a sliding window of timestamped samples, each kept in a Resizable_deque
+//
+// Samples are pushed at the back in order of non-decreasing time, and evict_before( t )
+// drops every sample older than t from the front; both take O(1) amortized time per
+// sample, however large the window, instead of rescanning it
+//
+// Monotonic_window reports the minimum (or, with std::greater, the maximum) of the window
+// Window_aggregator reports the fold of the window under any associative operation, for
+// example a sum, a product or a gcd
+
+// A sample: a value and the time it was taken
+template <typename Type>
+class Window_sample {
+	public:
+		long long time;
+		Type value;
+};
+
+// The extremum of a window under Compare: the minimum for std::less, the maximum for std::greater
+//
+// Only the samples that can still become the extremum are kept: a sample is dropped as soon
+// as a later sample compares at least as well, since the later one leaves the window last
+// The kept samples are therefore ordered by both time and value, and the extremum is at the front
+template <typename Type, typename Compare = std::less<Type> >
+class Monotonic_window {
+	public:
+		Monotonic_window( Compare const & = Compare() );
+
+		Type extremum() const;
+		bool empty() const;
+		int candidates() const;
+
+		void push_back( long long, Type const & );
+		template <typename Iterator>
+		void push_back( Iterator, Iterator );
+		void evict_before( long long );
+		void clear();
+
+	private:
+		Resizable_deque<Window_sample<Type>, Power_of_two_policy> kept;
+		Compare compare;
+
+		int undominated_count( Type const & ) const;
+};
+
+// The fold of a window under an associative operation, with the two-stack method
+//
+// The oldest samples form the front stack: each stores the fold of itself and every later
+// sample of the front stack, so the front one holds the fold of the whole stack
+// The newer samples form the back stack, of which only the running fold is kept
+// A push only extends the running fold; when evictions empty the front stack, the back stack
+// becomes the front one and its suffix folds are computed in one pass, so each sample is
+// folded a constant number of times
+// Both stacks share one deque: its first front_size samples are the front stack
+template <typename Type, typename Operation = std::plus<Type> >
+class Window_aggregator {
+	public:
+		Window_aggregator( Operation const & = Operation() );
+
+		Type aggregate() const;
+		int size() const;
+		bool empty() const;
+
+		void push_back( long long, Type const & );
+		template <typename Iterator>
+		void push_back( Iterator, Iterator );
+		void evict_before( long long );
+		void clear();
+
+	private:
+		class Entry {
+			public:
+				long long time;
+				Type value;
+				Type suffix;
+		};
+
+		Resizable_deque<Entry, Power_of_two_policy> entries;
+		int front_size;
+		Type back_fold;
+		Operation operation;
+
+		void flip();
+};
+
+/////////////////////////////////////////////////////////////////////////
+//                   Constructors and Destructors                      //
+/////////////////////////////////////////////////////////////////////////
+
+template <typename Type, typename Compare>
+Monotonic_window<Type, Compare>::Monotonic_window( Compare const &c ):
+kept(),
+compare( c ) {
+	// empty constructor
+}
+
+template <typename Type, typename Operation>
+Window_aggregator<Type, Operation>::Window_aggregator( Operation const &op ):
+entries(),
+front_size( 0 ),
+back_fold(),
+operation( op ) {
+	// empty constructor
+}
+
+/////////////////////////////////////////////////////////////////////////
+//                     Public Member Functions                         //
+/////////////////////////////////////////////////////////////////////////
+
+// Return the extremum of the samples in the window
+template <typename Type, typename Compare>
+Type Monotonic_window<Type, Compare>::extremum() const {
+    if ( kept.empty() )
+        throw underflow();
+
+    return kept[0].value;
+}
+
+// The window is empty exactly when no sample is kept, since the newest sample always is
+template <typename Type, typename Compare>
+bool Monotonic_window<Type, Compare>::empty() const {
+	return kept.empty();
+}
+
+// Return the number of samples kept, which is at most the number in the window
+template <typename Type, typename Compare>
+int Monotonic_window<Type, Compare>::candidates() const {
+	return kept.size();
+}
+
+// Add a sample taken at the given time, which must not be earlier than the last one
+template <typename Type, typename Compare>
+void Monotonic_window<Type, Compare>::push_back( long long time, Type const &value ) {
+    kept.pop_back( kept.size() - undominated_count( value ) );
+
+    Window_sample<Type> sample = { time, value };
+    kept.push_back( sample );
+}
+
+// Add a block of Window_sample objects in order of time
+// Within the block only the samples that no later sample of the block dominates can be kept,
+// so those are found first by a backwards scan and pushed together
+template <typename Type, typename Compare>
+template <typename Iterator>
+void Monotonic_window<Type, Compare>::push_back( Iterator first, Iterator last ) {
+    std::vector<Window_sample<Type> > block( first, last );
+
+    if ( block.empty() )
+        return;
+
+    // Collect the survivors from the newest back, then put them in order of time
+    std::vector<Window_sample<Type> > survivors;
+    survivors.push_back( block.back() );
+
+    for ( int i = static_cast<int>( block.size() ) - 2; i >= 0; --i ) {
+        if ( compare( block[i].value, survivors.back().value ) )
+            survivors.push_back( block[i] );
+    }
+
+    std::reverse( survivors.begin(), survivors.end() );
+
+    // The oldest survivor decides how many of the samples already kept it dominates
+    kept.pop_back( kept.size() - undominated_count( survivors.front().value ) );
+    kept.push_back( survivors.begin(), survivors.end() );
+}
+
+// Drop every sample taken before the given time
+// The kept samples are in order of time, so the ones to drop are found by binary search
+template <typename Type, typename Compare>
+void Monotonic_window<Type, Compare>::evict_before( long long time ) {
+    int n = static_cast<int>( std::lower_bound( kept.begin(), kept.end(), time,
+        []( Window_sample<Type> const &sample, long long t ) { return sample.time < t; } ) - kept.begin() );
+
+    kept.pop_front( n );
+}
+
+template <typename Type, typename Compare>
+void Monotonic_window<Type, Compare>::clear() {
+	kept.clear();
+}
+
+// Return the fold of the samples in the window, oldest first
+template <typename Type, typename Operation>
+Type Window_aggregator<Type, Operation>::aggregate() const {
+    if ( entries.empty() )
+        throw underflow();
+
+    if ( front_size == 0 )
+        return back_fold;
+
+    if ( front_size == entries.size() )
+        return entries[0].suffix;
+
+    return operation( entries[0].suffix, back_fold );
+}
+
+template <typename Type, typename Operation>
+int Window_aggregator<Type, Operation>::size() const {
+	return entries.size();
+}
+
+template <typename Type, typename Operation>
+bool Window_aggregator<Type, Operation>::empty() const {
+	return entries.empty();
+}
+
+// Add a sample taken at the given time, which must not be earlier than the last one
+template <typename Type, typename Operation>
+void Window_aggregator<Type, Operation>::push_back( long long time, Type const &value ) {
+    back_fold = (front_size == entries.size()) ? value : operation( back_fold, value );
+
+    Entry entry = { time, value, value };
+    entries.push_back( entry );
+}
+
+// Add a block of Window_sample objects in order of time, reserving room for all of them at once
+template <typename Type, typename Operation>
+template <typename Iterator>
+void Window_aggregator<Type, Operation>::push_back( Iterator first, Iterator last ) {
+    entries.reserve( entries.size() + static_cast<int>( std::distance( first, last ) ) );
+
+    for ( ; first != last; ++first ) {
+        push_back( first->time, first->value );
+    }
+}
+
+// Drop every sample taken before the given time
+template <typename Type, typename Operation>
+void Window_aggregator<Type, Operation>::evict_before( long long time ) {
+    int n = static_cast<int>( std::lower_bound( entries.begin(), entries.end(), time,
+        []( Entry const &entry, long long t ) { return entry.time < t; } ) - entries.begin() );
+
+    if ( n == 0 )
+        return;
+
+    entries.pop_front( n );
+
+    if ( n < front_size ) {
+        front_size -= n;
+    } else {
+        // The front stack is gone, along with any evicted samples of the back stack
+        front_size = 0;
+        flip();
+    }
+}
+
+template <typename Type, typename Operation>
+void Window_aggregator<Type, Operation>::clear() {
+    entries.clear();
+    front_size = 0;
+}
+
+/////////////////////////////////////////////////////////////////////////
+//                      Private member functions                       //
+/////////////////////////////////////////////////////////////////////////
+
+// Return the number of kept samples, from the front, that a new sample with this value leaves kept
+template <typename Type, typename Compare>
+int Monotonic_window<Type, Compare>::undominated_count( Type const &value ) const {
+    int n = kept.size();
+
+    while ( n > 0 && !compare( kept[n - 1].value, value ) ) {
+        --n;
+    }
+
+    return n;
+}
+
+// Make every sample part of the front stack, computing the suffix folds from the newest back
+template <typename Type, typename Operation>
+void Window_aggregator<Type, Operation>::flip() {
+    int n = entries.size();
+
+    if ( n == 0 )
+        return;
+
+    entries[n - 1].suffix = entries[n - 1].value;
+
+    for ( int i = n - 2; i >= 0; --i ) {
+        entries[i].suffix = operation( entries[i].value, entries[i + 1].suffix );
+    }
+
+    front_size = n;
+}
+
+#endif
@@ -0,0 +1,499 @@
+#ifndef SMALL_DEQUE_H
+#define SMALL_DEQUE_H
+
+#include <algorithm>
+#include <cstring>
+#include <iterator>
+#include <new>
+#include <type_traits>
+#include <utility>
+#include "Exception.h"
+#include "Index_iterator.h"
+
+// A circular-array deque, like Resizable_deque, that keeps up to N elements in a buffer
+// inside the object itself
+// Constructing, filling up to N and destroying it never touches the heap; a push past
+// the inline capacity moves the elements to a heap array that then doubles as usual
+// clear() and shrink_to_fit() return to the inline buffer when the elements fit in it
+//
+// It has the interface that Deque.h lists as common to all layouts; a moved-from deque is empty
+template <typename Type, int N = 8>
+class Small_deque {
+	static_assert( N >= 1, "A Small_deque needs room for at least one element inline" );
+
+	public:
+		typedef Index_iterator<Small_deque, Type> iterator;
+		typedef Index_iterator<Small_deque const, Type const> const_iterator;
+
+		Small_deque( int = N );
+		Small_deque( Small_deque const & );
+		Small_deque( Small_deque && );
+		~Small_deque();
+
+		Type front() const;
+		Type back() const;
+		int size() const;
+		bool empty() const;
+		int capacity() const;
+		bool is_inline() const;
+		Type const &operator[]( int ) const;
+		const_iterator begin() const;
+		const_iterator end() const;
+
+		Type &operator[]( int );
+		iterator begin();
+		iterator end();
+		void swap( Small_deque & );
+		Small_deque &operator=( Small_deque const & );
+		Small_deque &operator=( Small_deque && );
+		void push_front( Type const & );
+		void push_back( Type const & );
+		template <typename Iterator, typename = typename std::iterator_traits<Iterator>::iterator_category>
+		void push_back( Iterator, Iterator );
+		void pop_front();
+		void pop_back();
+		void pop_front( int );
+		void pop_back( int );
+		void reserve( int );
+		void shrink_to_fit();
+		void clear();
+
+	private:
+		typename std::aligned_storage<sizeof( Type ), alignof( Type )>::type buffer[N];
+
+		// The element at index k of the deque is array[(start + k) % array_capacity],
+		// where array is either the inline buffer or a heap array
+		Type *array;
+		int array_capacity;
+		int start;
+		int deque_size;
+
+		Type *inline_array();
+		int index_of( int ) const;
+		void move_elements( Type *, int );
+		void take( Small_deque & );
+		void destroy_all();
+		template <typename Iterator>
+		void push_back_range( Iterator, Iterator, std::input_iterator_tag );
+		template <typename Iterator>
+		void push_back_range( Iterator, Iterator, std::forward_iterator_tag );
+
+	// Friends
+
+	template <typename T, int M>
+	friend std::ostream &operator<<( std::ostream &, Small_deque<T, M> const & );
+};
+
+/////////////////////////////////////////////////////////////////////////
+//                   Constructors and Destructors                      //
+/////////////////////////////////////////////////////////////////////////
+
+// Constructor
+// The deque starts in its inline buffer, without allocating, unless it is asked for
+// room for more than N elements
+template <typename Type, int N>
+Small_deque<Type, N>::Small_deque( int n ):
+array( inline_array() ),
+array_capacity( N ),
+start( 0 ),
+deque_size( 0 ) {
+    if ( n > N ) {
+        array = static_cast<Type *>( ::operator new( n * sizeof( Type ) ) );
+        array_capacity = n;
+    }
+}
+
+// Copy Constructor
+// The copy is inline if the elements fit, whatever the argument's capacity
+template <typename Type, int N>
+Small_deque<Type, N>::Small_deque( Small_deque const &deque ):
+array( inline_array() ),
+array_capacity( N ),
+start( 0 ),
+deque_size( 0 ) {
+    if ( deque.size() > N ) {
+        array = static_cast<Type *>( ::operator new( deque.size() * sizeof( Type ) ) );
+        array_capacity = deque.size();
+    }
+
+    for ( int k = 0; k < deque.size(); ++k ) {
+        new ( array + k ) Type( deque[k] );
+        ++deque_size;
+    }
+}
+
+// Move Constructor
+// A heap array is taken over; inline elements can only be moved one by one
+template <typename Type, int N>
+Small_deque<Type, N>::Small_deque( Small_deque &&deque ):
+array( inline_array() ),
+array_capacity( N ),
+start( 0 ),
+deque_size( 0 ) {
+	take( deque );
+}
+
+// Destructor
+template <typename Type, int N>
+Small_deque<Type, N>::~Small_deque() {
+	clear();
+}
+
+/////////////////////////////////////////////////////////////////////////
+//                     Public Member Functions                         //
+/////////////////////////////////////////////////////////////////////////
+
+template <typename Type, int N>
+int Small_deque<Type, N>::size() const {
+	return deque_size;
+}
+
+template <typename Type, int N>
+int Small_deque<Type, N>::capacity() const {
+	return array_capacity;
+}
+
+template <typename Type, int N>
+bool Small_deque<Type, N>::empty() const {
+	return deque_size == 0;
+}
+
+// Return true if the elements are in the inline buffer rather than on the heap
+template <typename Type, int N>
+bool Small_deque<Type, N>::is_inline() const {
+	return array == reinterpret_cast<Type const *>( buffer );
+}
+
+template <typename Type, int N>
+Type Small_deque<Type, N>::front() const {
+	if ( empty() )
+		throw underflow();
+
+	return array[start];
+}
+
+template <typename Type, int N>
+Type Small_deque<Type, N>::back() const {
+	if ( empty() )
+		throw underflow();
+
+	return array[index_of( deque_size - 1 )];
+}
+
+// Return the k-th element from the front, for 0 <= k < size(); the index is not checked
+template <typename Type, int N>
+Type const &Small_deque<Type, N>::operator[]( int k ) const {
+	return array[index_of( k )];
+}
+
+template <typename Type, int N>
+Type &Small_deque<Type, N>::operator[]( int k ) {
+	return array[index_of( k )];
+}
+
+template <typename Type, int N>
+typename Small_deque<Type, N>::const_iterator Small_deque<Type, N>::begin() const {
+	return const_iterator( this, 0 );
+}
+
+template <typename Type, int N>
+typename Small_deque<Type, N>::const_iterator Small_deque<Type, N>::end() const {
+	return const_iterator( this, deque_size );
+}
+
+template <typename Type, int N>
+typename Small_deque<Type, N>::iterator Small_deque<Type, N>::begin() {
+	return iterator( this, 0 );
+}
+
+template <typename Type, int N>
+typename Small_deque<Type, N>::iterator Small_deque<Type, N>::end() {
+	return iterator( this, deque_size );
+}
+
+// Swap by moves, since inline elements cannot be exchanged by swapping pointers
+template <typename Type, int N>
+void Small_deque<Type, N>::swap( Small_deque &deque ) {
+    if ( this == &deque )
+        return;
+
+    Small_deque tmp( std::move( deque ) );
+    deque.take( *this );
+    take( tmp );
+}
+
+template <typename Type, int N>
+Small_deque<Type, N> &Small_deque<Type, N>::operator=( Small_deque const &rhs ) {
+	Small_deque copy( rhs );
+	swap( copy );
+
+	return *this;
+}
+
+template <typename Type, int N>
+Small_deque<Type, N> &Small_deque<Type, N>::operator=( Small_deque &&rhs ) {
+    if ( this != &rhs ) {
+        clear();
+        take( rhs );
+    }
+
+	return *this;
+}
+
+// Insert an object at the front, doubling the capacity if the deque is full
+// The object is constructed before the old ones are moved, in case it refers to one of them
+template <typename Type, int N>
+void Small_deque<Type, N>::push_front( Type const &obj ) {
+    if ( deque_size == array_capacity ) {
+        Type *bigger = static_cast<Type *>( ::operator new( 2 * array_capacity * sizeof( Type ) ) );
+        new ( bigger ) Type( obj );
+        move_elements( bigger, 1 );
+        array_capacity *= 2;
+        start = 0;
+    } else {
+        int i = (start == 0) ? array_capacity - 1 : start - 1;
+        new ( array + i ) Type( obj );
+        start = i;
+    }
+
+    ++deque_size;
+}
+
+// Insert an object at the back, doubling the capacity if the deque is full
+template <typename Type, int N>
+void Small_deque<Type, N>::push_back( Type const &obj ) {
+    if ( deque_size == array_capacity ) {
+        Type *bigger = static_cast<Type *>( ::operator new( 2 * array_capacity * sizeof( Type ) ) );
+        new ( bigger + deque_size ) Type( obj );
+        move_elements( bigger, 0 );
+        array_capacity *= 2;
+        start = 0;
+    } else {
+        new ( array + index_of( deque_size ) ) Type( obj );
+    }
+
+    ++deque_size;
+}
+
+// Remove the object at the front
+// The array is never shrunk by a pop; see shrink_to_fit()
+template <typename Type, int N>
+void Small_deque<Type, N>::pop_front() {
+    if ( empty() )
+        throw underflow();
+
+    array[start].~Type();
+    start = (start + 1 == array_capacity) ? 0 : start + 1;
+    --deque_size;
+}
+
+// Remove the object at the back
+template <typename Type, int N>
+void Small_deque<Type, N>::pop_back() {
+    if ( empty() )
+        throw underflow();
+
+    array[index_of( deque_size - 1 )].~Type();
+    --deque_size;
+}
+
+// Insert copies of the objects in [first, last) at the back, in order
+// When the length of the range is known the array grows at most once;
+// the range must not refer into this deque
+template <typename Type, int N>
+template <typename Iterator, typename>
+void Small_deque<Type, N>::push_back( Iterator first, Iterator last ) {
+    push_back_range( first, last, typename std::iterator_traits<Iterator>::iterator_category() );
+}
+
+// Remove the n objects at the front
+template <typename Type, int N>
+void Small_deque<Type, N>::pop_front( int n ) {
+    if ( n < 0 )
+        throw illegal_argument();
+
+    if ( n > deque_size )
+        throw underflow();
+
+    if ( !std::is_trivially_destructible<Type>::value ) {
+        for ( int k = 0; k < n; ++k ) {
+            array[index_of( k )].~Type();
+        }
+    }
+
+    start = index_of( n );
+    deque_size -= n;
+}
+
+// Remove the n objects at the back
+template <typename Type, int N>
+void Small_deque<Type, N>::pop_back( int n ) {
+    if ( n < 0 )
+        throw illegal_argument();
+
+    if ( n > deque_size )
+        throw underflow();
+
+    if ( !std::is_trivially_destructible<Type>::value ) {
+        for ( int k = deque_size - n; k < deque_size; ++k ) {
+            array[index_of( k )].~Type();
+        }
+    }
+
+    deque_size -= n;
+}
+
+// Make room for at least n objects, moving the elements to a heap array of n if they need one
+template <typename Type, int N>
+void Small_deque<Type, N>::reserve( int n ) {
+    if ( n <= array_capacity )
+        return;
+
+    move_elements( static_cast<Type *>( ::operator new( n * sizeof( Type ) ) ), 0 );
+    array_capacity = n;
+    start = 0;
+}
+
+// Move the elements back into the inline buffer if they fit, and otherwise into a
+// heap array of exactly their number
+template <typename Type, int N>
+void Small_deque<Type, N>::shrink_to_fit() {
+    if ( is_inline() || deque_size == array_capacity )
+        return;
+
+    int new_capacity = std::max( deque_size, N );
+    Type *destination = (deque_size <= N) ? inline_array()
+                      : static_cast<Type *>( ::operator new( new_capacity * sizeof( Type ) ) );
+
+    move_elements( destination, 0 );
+    array_capacity = new_capacity;
+    start = 0;
+}
+
+// Destroy the elements and return to the inline buffer
+template <typename Type, int N>
+void Small_deque<Type, N>::clear() {
+    destroy_all();
+
+    if ( !is_inline() )
+        ::operator delete( array );
+
+    array = inline_array();
+    array_capacity = N;
+    start = 0;
+    deque_size = 0;
+}
+
+/////////////////////////////////////////////////////////////////////////
+//                      Private member functions                       //
+/////////////////////////////////////////////////////////////////////////
+
+template <typename Type, int N>
+Type *Small_deque<Type, N>::inline_array() {
+    return reinterpret_cast<Type *>( buffer );
+}
+
+// Return the index of the array holding the k-th element from the front, for 0 <= k <= capacity()
+template <typename Type, int N>
+int Small_deque<Type, N>::index_of( int k ) const {
+    int i = start + k;
+
+    return (i >= array_capacity) ? i - array_capacity : i;
+}
+
+// Move the elements, front first, into destination starting at index i, then free the
+// old array if it was on the heap and make destination the array
+// The capacity and start are left for the caller to update
+template <typename Type, int N>
+void Small_deque<Type, N>::move_elements( Type *destination, int i ) {
+    if ( std::is_trivially_copyable<Type>::value ) {
+        int first_segment = std::min( deque_size, array_capacity - start );
+        std::memcpy( static_cast<void *>( destination + i ), array + start, first_segment * sizeof( Type ) );
+        std::memcpy( static_cast<void *>( destination + i + first_segment ), array, (deque_size - first_segment) * sizeof( Type ) );
+    } else {
+        for ( int k = 0; k < deque_size; ++k ) {
+            Type &obj = array[index_of( k )];
+            new ( destination + i + k ) Type( std::move( obj ) );
+            obj.~Type();
+        }
+    }
+
+    if ( !is_inline() )
+        ::operator delete( array );
+
+    array = destination;
+}
+
+// Take the elements of an other deque, leaving it empty and inline; this deque must be
+// empty and inline
+template <typename Type, int N>
+void Small_deque<Type, N>::take( Small_deque &deque ) {
+    if ( deque.is_inline() ) {
+        for ( int k = 0; k < deque.deque_size; ++k ) {
+            Type &obj = deque[k];
+            new ( array + k ) Type( std::move( obj ) );
+            obj.~Type();
+        }
+    } else {
+        array = deque.array;
+        array_capacity = deque.array_capacity;
+        start = deque.start;
+        deque.array = deque.inline_array();
+        deque.array_capacity = N;
+    }
+
+    deque_size = deque.deque_size;
+    deque.start = 0;
+    deque.deque_size = 0;
+}
+
+// Push the objects of an input range one at a time, since its length is not known in advance
+template <typename Type, int N>
+template <typename Iterator>
+void Small_deque<Type, N>::push_back_range( Iterator first, Iterator last, std::input_iterator_tag ) {
+    for ( ; first != last; ++first ) {
+        push_back( *first );
+    }
+}
+
+// Grow the array once for the whole range, at least doubling it as a single push would,
+// then copy-construct each object in its slot
+template <typename Type, int N>
+template <typename Iterator>
+void Small_deque<Type, N>::push_back_range( Iterator first, Iterator last, std::forward_iterator_tag ) {
+    int n = static_cast<int>( std::distance( first, last ) );
+
+    if ( deque_size + n > array_capacity )
+        reserve( std::max( deque_size + n, 2 * array_capacity ) );
+
+    for ( ; first != last; ++first ) {
+        new ( array + index_of( deque_size ) ) Type( *first );
+        ++deque_size;
+    }
+}
+
+// Destroy every element, leaving the indices unchanged
+template <typename Type, int N>
+void Small_deque<Type, N>::destroy_all() {
+    if ( std::is_trivially_destructible<Type>::value )
+        return;
+
+    for ( int k = 0; k < deque_size; ++k ) {
+        array[index_of( k )].~Type();
+    }
+}
+
+/////////////////////////////////////////////////////////////////////////
+//                               Friends                               //
+/////////////////////////////////////////////////////////////////////////
+
+template <typename T, int M>
+std::ostream &operator<<( std::ostream &out, Small_deque<T, M> const &deque ) {
+	for ( int k = 0; k < deque.size(); ++k ) {
+		out << deque[k] << ' ';
+	}
+
+	return out;
+}
+
+#endif
@@ -0,0 +1,231 @@
+#ifndef SPSC_QUEUE_H
+#define SPSC_QUEUE_H
+
+#include <atomic>
+#include <cstddef>
+#include <new>
+#include <utility>
+
+// A bounded lock-free queue between exactly one producer thread and one consumer thread
+//
+// The objects sit in a circular array of 2^k slots indexed, like Work_stealing_deque, by
+// unbounded counters masked on access: the producer only writes back and the consumer only
+// writes front, so neither needs a lock or a read-modify-write instruction
+// Each side keeps a private copy of the other side's counter and only re-reads the shared
+// one when the copy says the queue is full (or empty), which keeps the two cache lines from
+// bouncing between the cores on every operation
+//
+// The batched push_back() and pop_front() move up to n objects with a single publication
+// of the counter, amortizing the cost of the cross-core write over the whole batch
+//
+// Only the producer may call push_back(), and only the consumer may call pop_front()
+template <typename Type>
+class Spsc_queue {
+	public:
+		Spsc_queue( int = 1024 );
+		~Spsc_queue();
+
+		int size() const;
+		bool empty() const;
+		int capacity() const;
+
+		bool push_back( Type const & );
+		bool push_back( Type && );
+		int push_back( Type const *, int );
+		bool pop_front( Type & );
+		int pop_front( Type *, int );
+
+	private:
+		static const int CACHE_LINE = 64;
+
+		// Fields written by the producer, then by the consumer, each on its own cache line
+		std::atomic<std::size_t> back;
+		std::size_t cached_front;
+		char producer_padding[CACHE_LINE - sizeof( std::atomic<std::size_t> ) - sizeof( std::size_t )];
+
+		std::atomic<std::size_t> front;
+		std::size_t cached_back;
+		char consumer_padding[CACHE_LINE - sizeof( std::atomic<std::size_t> ) - sizeof( std::size_t )];
+
+		std::size_t mask;
+		Type *array;
+
+		template <typename Arg>
+		bool emplace_back( Arg && );
+
+		// The queue is shared by address between its two threads and is never copied
+		Spsc_queue( Spsc_queue const & );
+		Spsc_queue &operator=( Spsc_queue const & );
+};
+
+/////////////////////////////////////////////////////////////////////////
+//                   Constructors and Destructors                      //
+/////////////////////////////////////////////////////////////////////////
+
+// Constructor
+// The capacity is n rounded up to a power of 2, and at least 2
+template <typename Type>
+Spsc_queue<Type>::Spsc_queue( int n ):
+back( 0 ),
+cached_front( 0 ),
+front( 0 ),
+cached_back( 0 ),
+mask( 0 ),
+array( nullptr ) {
+    std::size_t queue_capacity = 2;
+
+    while ( queue_capacity < static_cast<std::size_t>( n ) ) {
+        queue_capacity *= 2;
+    }
+
+    mask = queue_capacity - 1;
+    array = static_cast<Type *>( ::operator new( queue_capacity * sizeof( Type ) ) );
+}
+
+// Destructor
+// Destroys the objects still in the queue; neither thread may be using it
+template <typename Type>
+Spsc_queue<Type>::~Spsc_queue() {
+    std::size_t b = back.load( std::memory_order_relaxed );
+
+    for ( std::size_t i = front.load( std::memory_order_relaxed ); i != b; ++i ) {
+        array[i & mask].~Type();
+    }
+
+    ::operator delete( array );
+}
+
+/////////////////////////////////////////////////////////////////////////
+//                     Public Member Functions                         //
+/////////////////////////////////////////////////////////////////////////
+
+//ACCESSORS
+
+// Return the number of objects in the queue
+// Called from any thread other than the two using the queue, this is only a snapshot
+template <typename Type>
+int Spsc_queue<Type>::size() const {
+    std::size_t f = front.load( std::memory_order_acquire );
+    std::size_t b = back.load( std::memory_order_acquire );
+
+    return static_cast<int>( b - f );
+}
+
+template <typename Type>
+bool Spsc_queue<Type>::empty() const {
+    return size() == 0;
+}
+
+template <typename Type>
+int Spsc_queue<Type>::capacity() const {
+    return static_cast<int>( mask + 1 );
+}
+
+//MUTATORS
+
+// Copy an object onto the back of the queue
+// Returns false, leaving the queue unchanged, if it is full
+template <typename Type>
+bool Spsc_queue<Type>::push_back( Type const &obj ) {
+    return emplace_back( obj );
+}
+
+// Move an object onto the back of the queue
+// Returns false, leaving the queue and the object unchanged, if it is full
+template <typename Type>
+bool Spsc_queue<Type>::push_back( Type &&obj ) {
+    return emplace_back( std::move( obj ) );
+}
+
+// Copy as many of the n objects as fit onto the back of the queue, publishing them together
+// Returns the number of objects pushed, which are always the first ones
+template <typename Type>
+int Spsc_queue<Type>::push_back( Type const *objs, int n ) {
+    std::size_t b = back.load( std::memory_order_relaxed );
+    std::size_t room = mask + 1 - (b - cached_front);
+
+    if ( room < static_cast<std::size_t>( n ) ) {
+        cached_front = front.load( std::memory_order_acquire );
+        room = mask + 1 - (b - cached_front);
+    }
+
+    int pushed = ( room < static_cast<std::size_t>( n ) ) ? static_cast<int>( room ) : n;
+
+    for ( int i = 0; i < pushed; ++i ) {
+        new ( array + ((b + i) & mask) ) Type( objs[i] );
+    }
+
+    back.store( b + pushed, std::memory_order_release );
+
+    return pushed;
+}
+
+// Move the object at the front of the queue into obj and remove it
+// Returns false, leaving obj unchanged, if the queue is empty
+template <typename Type>
+bool Spsc_queue<Type>::pop_front( Type &obj ) {
+    std::size_t f = front.load( std::memory_order_relaxed );
+
+    if ( f == cached_back ) {
+        cached_back = back.load( std::memory_order_acquire );
+
+        if ( f == cached_back )
+            return false;
+    }
+
+    Type &slot = array[f & mask];
+    obj = std::move( slot );
+    slot.~Type();
+
+    front.store( f + 1, std::memory_order_release );
+
+    return true;
+}
+
+// Move up to n objects from the front of the queue into objs, releasing their slots together
+// Returns the number of objects removed
+template <typename Type>
+int Spsc_queue<Type>::pop_front( Type *objs, int n ) {
+    std::size_t f = front.load( std::memory_order_relaxed );
+
+    if ( cached_back - f < static_cast<std::size_t>( n ) )
+        cached_back = back.load( std::memory_order_acquire );
+
+    std::size_t available = cached_back - f;
+    int popped = ( available < static_cast<std::size_t>( n ) ) ? static_cast<int>( available ) : n;
+
+    for ( int i = 0; i < popped; ++i ) {
+        Type &slot = array[(f + i) & mask];
+        objs[i] = std::move( slot );
+        slot.~Type();
+    }
+
+    front.store( f + popped, std::memory_order_release );
+
+    return popped;
+}
+
+/////////////////////////////////////////////////////////////////////////
+//                      Private member functions                       //
+/////////////////////////////////////////////////////////////////////////
+
+// Construct an object at the back of the queue from the argument, unless the queue is full
+template <typename Type>
+template <typename Arg>
+bool Spsc_queue<Type>::emplace_back( Arg &&arg ) {
+    std::size_t b = back.load( std::memory_order_relaxed );
+
+    if ( b - cached_front > mask ) {
+        cached_front = front.load( std::memory_order_acquire );
+
+        if ( b - cached_front > mask )
+            return false;
+    }
+
+    new ( array + (b & mask) ) Type( std::forward<Arg>( arg ) );
+    back.store( b + 1, std::memory_order_release );
+
+    return true;
+}
+
+#endif
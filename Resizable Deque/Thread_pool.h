@@ -0,0 +1,335 @@
+#ifndef THREAD_POOL_H
+#define THREAD_POOL_H
+
+#include <algorithm>
+#include <atomic>
+#include <condition_variable>
+#include <functional>
+#include <mutex>
+#include <thread>
+#include <utility>
+#include <vector>
+#include "Work_stealing_deque.h"
+
+// A fixed set of worker threads that schedule tasks with work stealing
+//
+// Every worker owns a Work_stealing_deque of tasks: a task submitted by a running task goes
+// on the back of its own worker's deque, each worker runs tasks from the back of its own
+// deque, and an idle worker steals from the front of the others, so there is no shared
+// task queue for the workers to contend on
+// Tasks submitted from outside the pool are handed to the workers in turn through small
+// per-worker inboxes, each with its own lock
+//
+// An idle worker sleeps until a task is submitted: submit() advances a work epoch, and a
+// worker only goes to sleep if the epoch is the one it saw before its last search for a task
+//
+// wait() blocks until every task submitted so far, including tasks they submit, has run
+// It must not be called from inside a task, but parallel_for() may be: it only waits for
+// its own range, and a worker calling it runs other tasks until the range is done
+class Thread_pool {
+	public:
+		typedef std::function<void()> Task;
+
+		Thread_pool( int = 0 );
+		~Thread_pool();
+
+		int size() const;
+
+		void submit( Task );
+		template <typename Function>
+		void parallel_for( int, int, int, Function );
+		void wait();
+
+	private:
+		class Worker {
+			public:
+				Work_stealing_deque<Task *> tasks;
+				std::mutex inbox_mutex;
+				std::vector<Task *> inbox;
+				std::thread thread;
+		};
+
+		std::vector<Worker *> workers;
+		std::atomic<int> pending;
+		std::atomic<int> sleeping;
+		std::atomic<unsigned> work_epoch;
+		std::atomic<unsigned> next_inbox;
+		std::atomic<bool> stopping;
+
+		std::mutex idle_mutex;
+		std::condition_variable work_available;
+		std::condition_variable all_done;
+
+		void run( int );
+		Task *find_task( int );
+		void finish_task( Task * );
+		template <typename Function>
+		void run_range( int, int, int, Function, std::atomic<int> * );
+		void finish_range( std::atomic<int> * );
+
+		static int &worker_index();
+		static Thread_pool *&worker_pool();
+
+		// The workers hold a pointer to the pool, so it is never copied
+		Thread_pool( Thread_pool const & );
+		Thread_pool &operator=( Thread_pool const & );
+};
+
+/////////////////////////////////////////////////////////////////////////
+//                   Constructors and Destructors                      //
+/////////////////////////////////////////////////////////////////////////
+
+// Constructor
+// Starts n workers, or one per hardware thread if n is not positive
+inline Thread_pool::Thread_pool( int n ):
+pending( 0 ),
+sleeping( 0 ),
+work_epoch( 0 ),
+next_inbox( 0 ),
+stopping( false ) {
+    if ( n <= 0 )
+        n = std::max( 1, static_cast<int>( std::thread::hardware_concurrency() ) );
+
+    for ( int i = 0; i < n; ++i ) {
+        workers.push_back( new Worker() );
+    }
+
+    // Start the threads only once every worker exists, since they steal from each other
+    for ( int i = 0; i < n; ++i ) {
+        workers[i]->thread = std::thread( &Thread_pool::run, this, i );
+    }
+}
+
+// Destructor
+// Waits for the outstanding tasks, then stops the workers
+inline Thread_pool::~Thread_pool() {
+    wait();
+
+    {
+        std::lock_guard<std::mutex> lock( idle_mutex );
+        stopping.store( true );
+    }
+
+    work_available.notify_all();
+
+    for ( std::size_t i = 0; i < workers.size(); ++i ) {
+        workers[i]->thread.join();
+    }
+
+    for ( std::size_t i = 0; i < workers.size(); ++i ) {
+        delete workers[i];
+    }
+}
+
+/////////////////////////////////////////////////////////////////////////
+//                     Public Member Functions                         //
+/////////////////////////////////////////////////////////////////////////
+
+// Return the number of worker threads
+inline int Thread_pool::size() const {
+    return static_cast<int>( workers.size() );
+}
+
+// Schedule a task to run on one of the workers
+inline void Thread_pool::submit( Task task ) {
+    Task *queued = new Task( std::move( task ) );
+
+    pending.fetch_add( 1 );
+
+    if ( worker_pool() == this ) {
+        // From a task: the owner of the deque is the calling thread
+        workers[worker_index()]->tasks.push_back( queued );
+    } else {
+        Worker *worker = workers[next_inbox.fetch_add( 1 ) % workers.size()];
+        std::lock_guard<std::mutex> lock( worker->inbox_mutex );
+        worker->inbox.push_back( queued );
+    }
+
+    // A worker about to sleep counts itself in sleeping before it rereads the epoch, so
+    // either it sees this advance or this sees it sleeping and wakes it under the lock
+    work_epoch.fetch_add( 1 );
+
+    if ( sleeping.load() > 0 ) {
+        std::lock_guard<std::mutex> lock( idle_mutex );
+        work_available.notify_one();
+    }
+}
+
+// Call f( i ) for every first <= i < last, in parallel, and wait for all the calls
+// The range is split in halves down to pieces of at most grain indices; the halves not
+// being worked on are left for idle workers to steal, while the calling thread works
+// through the lower halves itself
+//
+// Only the pieces of this range are waited for, counted in remaining, so a task can call
+// parallel_for(); a worker runs other tasks while it waits, so that nested ranges cannot
+// leave every worker blocked with the pieces they wait for still queued
+template <typename Function>
+void Thread_pool::parallel_for( int first, int last, int grain, Function f ) {
+    if ( first >= last )
+        return;
+
+    if ( grain < 1 )
+        grain = 1;
+
+    std::atomic<int> remaining( 1 );
+
+    run_range( first, last, grain, f, &remaining );
+    finish_range( &remaining );
+
+    if ( worker_pool() == this ) {
+        while ( remaining.load() > 0 ) {
+            Task *task = find_task( worker_index() );
+
+            if ( task != nullptr ) {
+                (*task)();
+                finish_task( task );
+            } else {
+                std::this_thread::yield();
+            }
+        }
+    } else {
+        std::unique_lock<std::mutex> lock( idle_mutex );
+
+        all_done.wait( lock, [&remaining]() { return remaining.load() == 0; } );
+    }
+}
+
+// Block until every submitted task has run
+inline void Thread_pool::wait() {
+    std::unique_lock<std::mutex> lock( idle_mutex );
+
+    all_done.wait( lock, [this]() { return pending.load() == 0; } );
+}
+
+/////////////////////////////////////////////////////////////////////////
+//                      Private member functions                       //
+/////////////////////////////////////////////////////////////////////////
+
+// The loop of worker i: run tasks until the pool stops
+inline void Thread_pool::run( int i ) {
+    worker_pool() = this;
+    worker_index() = i;
+
+    while ( true ) {
+        // Any task submitted after this read advances the epoch, so it cannot be slept through
+        unsigned epoch = work_epoch.load();
+        Task *task = find_task( i );
+
+        if ( task != nullptr ) {
+            (*task)();
+            finish_task( task );
+            continue;
+        }
+
+        std::unique_lock<std::mutex> lock( idle_mutex );
+
+        if ( stopping.load() )
+            return;
+
+        sleeping.fetch_add( 1 );
+        work_available.wait( lock, [this, epoch]() {
+            return stopping.load() || work_epoch.load() != epoch;
+        } );
+        sleeping.fetch_sub( 1 );
+    }
+}
+
+// Return a task for worker i, or nullptr if none could be found
+// The worker's own deque comes first, then its inbox, then the other workers' deques
+inline Thread_pool::Task *Thread_pool::find_task( int i ) {
+    Worker *self = workers[i];
+    Task *task = nullptr;
+
+    if ( self->tasks.pop_back( task ) )
+        return task;
+
+    {
+        std::lock_guard<std::mutex> lock( self->inbox_mutex );
+
+        for ( std::size_t k = 0; k < self->inbox.size(); ++k ) {
+            self->tasks.push_back( self->inbox[k] );
+        }
+
+        self->inbox.clear();
+    }
+
+    if ( self->tasks.pop_back( task ) )
+        return task;
+
+    int n = size();
+
+    for ( int k = 1; k < n; ++k ) {
+        if ( workers[(i + k) % n]->tasks.steal( task ) )
+            return task;
+    }
+
+    // Inboxes of other workers, which may be busy with a long task
+    for ( int k = 1; k < n; ++k ) {
+        Worker *other = workers[(i + k) % n];
+        std::lock_guard<std::mutex> lock( other->inbox_mutex );
+
+        if ( !other->inbox.empty() ) {
+            task = other->inbox.back();
+            other->inbox.pop_back();
+            return task;
+        }
+    }
+
+    return nullptr;
+}
+
+// Free a task that has run and wake wait() if it was the last one
+inline void Thread_pool::finish_task( Task *task ) {
+    delete task;
+
+    if ( pending.fetch_sub( 1 ) == 1 ) {
+        std::lock_guard<std::mutex> lock( idle_mutex );
+        all_done.notify_all();
+    }
+}
+
+// Run f over [first, last), splitting off the upper half as a new task while the range is larger than grain
+// Each split-off half is counted in remaining until it has run
+template <typename Function>
+void Thread_pool::run_range( int first, int last, int grain, Function f, std::atomic<int> *remaining ) {
+    while ( last - first > grain ) {
+        int middle = first + (last - first) / 2;
+
+        remaining->fetch_add( 1 );
+        submit( [this, middle, last, grain, f, remaining]() {
+            run_range( middle, last, grain, f, remaining );
+            finish_range( remaining );
+        } );
+
+        last = middle;
+    }
+
+    for ( int i = first; i < last; ++i ) {
+        f( i );
+    }
+}
+
+// Count a piece of a parallel_for() range as done and wake its caller if it was the last one
+// The caller may return as soon as remaining reaches 0, so it is not touched afterwards
+inline void Thread_pool::finish_range( std::atomic<int> *remaining ) {
+    if ( remaining->fetch_sub( 1 ) == 1 ) {
+        std::lock_guard<std::mutex> lock( idle_mutex );
+        all_done.notify_all();
+    }
+}
+
+// The index of the worker running on the calling thread
+inline int &Thread_pool::worker_index() {
+    static thread_local int index = -1;
+
+    return index;
+}
+
+// The pool the calling thread is a worker of, or nullptr
+inline Thread_pool *&Thread_pool::worker_pool() {
+    static thread_local Thread_pool *pool = nullptr;
+
+    return pool;
+}
+
+#endif
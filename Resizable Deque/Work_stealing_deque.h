@@ -0,0 +1,253 @@
+#ifndef WORK_STEALING_DEQUE_H
+#define WORK_STEALING_DEQUE_H
+
+#include <atomic>
+#include <cstdint>
+#include <type_traits>
+#include <vector>
+
+// A Chase-Lev work-stealing deque: a growable circular array like Resizable_deque, shared
+// between one owning thread and any number of thieves without a lock
+//
+// Only the owner may call push_back() and pop_back(), which work on the back of the deque
+// and are wait-free except when the array grows; any thread may call steal(), which takes
+// from the front and fails rather than blocking when it races with another thief or with
+// the owner over the last element
+//
+// The front and back are unbounded counters, masked into the array on access, so the ring
+// never needs a special case for wrapping around or for being empty
+// Growing copies the live elements into an array twice the size; the old arrays may still
+// be read by thieves, so they are only freed with the deque
+//
+// Elements are read and written atomically, so Type must be trivially copyable: typically
+// a pointer or an index
+// Based on Le, Pop, Cohen and Zappa Nardelli, "Correct and Efficient Work-Stealing for
+// Weak Memory Models", with the fences replaced by sequentially consistent accesses
+template <typename Type>
+class Work_stealing_deque {
+	static_assert( std::is_trivially_copyable<Type>::value, "Work_stealing_deque elements must be trivially copyable" );
+
+	public:
+		Work_stealing_deque( int = 64 );
+		~Work_stealing_deque();
+
+		int size() const;
+		bool empty() const;
+		int capacity() const;
+
+		void push_back( Type const & );
+		bool pop_back( Type & );
+		bool steal( Type & );
+
+	private:
+		// A circular array of 2^power atomic slots
+		class Ring {
+			public:
+				Ring( int );
+				~Ring();
+
+				std::int64_t mask;
+				std::atomic<Type> *slots;
+
+				Type get( std::int64_t ) const;
+				void put( std::int64_t, Type const & );
+		};
+
+		// Padded onto separate cache lines, since thieves write front while the owner writes back
+		// Padding rather than alignas keeps the deque allocatable with plain new before C++17
+		std::atomic<std::int64_t> front;
+		char front_padding[64 - sizeof( std::atomic<std::int64_t> )];
+		std::atomic<std::int64_t> back;
+		char back_padding[64 - sizeof( std::atomic<std::int64_t> )];
+		std::atomic<Ring *> ring;
+
+		// Arrays replaced by growth, owned by the deque until it is destroyed
+		std::vector<Ring *> retired;
+
+		Ring *grow( Ring *, std::int64_t, std::int64_t );
+
+		// The deque is shared by address between threads and is never copied
+		Work_stealing_deque( Work_stealing_deque const & );
+		Work_stealing_deque &operator=( Work_stealing_deque const & );
+};
+
+/////////////////////////////////////////////////////////////////////////
+//                   Constructors and Destructors                      //
+/////////////////////////////////////////////////////////////////////////
+
+// Ring constructor
+// The capacity is n rounded up to a power of 2
+template <typename Type>
+Work_stealing_deque<Type>::Ring::Ring( int n ):
+mask( 0 ),
+slots( nullptr ) {
+    std::int64_t ring_capacity = 1;
+
+    while ( ring_capacity < n ) {
+        ring_capacity *= 2;
+    }
+
+    mask = ring_capacity - 1;
+    slots = new std::atomic<Type>[ring_capacity];
+}
+
+// Ring destructor
+template <typename Type>
+Work_stealing_deque<Type>::Ring::~Ring() {
+    delete [] slots;
+}
+
+// Constructor
+// The array starts with room for n elements, rounded up to a power of 2
+template <typename Type>
+Work_stealing_deque<Type>::Work_stealing_deque( int n ):
+front( 0 ),
+back( 0 ),
+ring( new Ring( (n > 1) ? n : 2 ) ) {
+	// empty constructor
+}
+
+// Destructor
+// No other thread may be using the deque
+template <typename Type>
+Work_stealing_deque<Type>::~Work_stealing_deque() {
+    delete ring.load( std::memory_order_relaxed );
+
+    for ( std::size_t i = 0; i < retired.size(); ++i ) {
+        delete retired[i];
+    }
+}
+
+/////////////////////////////////////////////////////////////////////////
+//                     Public Member Functions                         //
+/////////////////////////////////////////////////////////////////////////
+
+//ACCESSORS
+
+// Return the number of elements
+// With other threads stealing this is only a snapshot
+template <typename Type>
+int Work_stealing_deque<Type>::size() const {
+    std::int64_t b = back.load( std::memory_order_relaxed );
+    std::int64_t f = front.load( std::memory_order_relaxed );
+
+    return (b > f) ? static_cast<int>( b - f ) : 0;
+}
+
+template <typename Type>
+bool Work_stealing_deque<Type>::empty() const {
+    return size() == 0;
+}
+
+// Return the number of elements the current array can hold
+template <typename Type>
+int Work_stealing_deque<Type>::capacity() const {
+    return static_cast<int>( ring.load( std::memory_order_relaxed )->mask + 1 );
+}
+
+//MUTATORS
+
+// Insert an object at the back; only the owner may call this
+// The array doubles if it is full
+template <typename Type>
+void Work_stealing_deque<Type>::push_back( Type const &obj ) {
+    std::int64_t b = back.load( std::memory_order_relaxed );
+    std::int64_t f = front.load( std::memory_order_acquire );
+    Ring *r = ring.load( std::memory_order_relaxed );
+
+    if ( b - f > r->mask )
+        r = grow( r, f, b );
+
+    r->put( b, obj );
+
+    // Publish the element: a thief that sees the new back also sees the element
+    back.store( b + 1, std::memory_order_release );
+}
+
+// Remove the object at the back into obj; only the owner may call this
+// Returns false if the deque is empty, or if a thief took the last element first
+template <typename Type>
+bool Work_stealing_deque<Type>::pop_back( Type &obj ) {
+    std::int64_t b = back.load( std::memory_order_relaxed ) - 1;
+    Ring *r = ring.load( std::memory_order_relaxed );
+
+    // Claim the back element before looking at the front, so that a thief reading
+    // back afterwards cannot take it as well
+    back.store( b, std::memory_order_seq_cst );
+    std::int64_t f = front.load( std::memory_order_seq_cst );
+
+    if ( f > b ) {
+        // The deque was empty
+        back.store( b + 1, std::memory_order_relaxed );
+        return false;
+    }
+
+    obj = r->get( b );
+
+    if ( f < b )
+        return true;
+
+    // This is the last element, which a thief may be taking at the same time:
+    // whoever advances the front gets it
+    bool won = front.compare_exchange_strong( f, f + 1, std::memory_order_seq_cst, std::memory_order_relaxed );
+    back.store( b + 1, std::memory_order_relaxed );
+
+    return won;
+}
+
+// Remove the object at the front into obj; any thread may call this
+// Returns false if the deque is empty or if another thread took the front element first,
+// in which case the caller should simply try again or look elsewhere
+template <typename Type>
+bool Work_stealing_deque<Type>::steal( Type &obj ) {
+    std::int64_t f = front.load( std::memory_order_seq_cst );
+    std::int64_t b = back.load( std::memory_order_seq_cst );
+
+    if ( f >= b )
+        return false;
+
+    Ring *r = ring.load( std::memory_order_acquire );
+    Type candidate = r->get( f );
+
+    if ( !front.compare_exchange_strong( f, f + 1, std::memory_order_seq_cst, std::memory_order_relaxed ) )
+        return false;
+
+    obj = candidate;
+
+    return true;
+}
+
+/////////////////////////////////////////////////////////////////////////
+//                      Private member functions                       //
+/////////////////////////////////////////////////////////////////////////
+
+// Read the slot at an unbounded index
+template <typename Type>
+Type Work_stealing_deque<Type>::Ring::get( std::int64_t i ) const {
+    return slots[i & mask].load( std::memory_order_relaxed );
+}
+
+// Write the slot at an unbounded index
+template <typename Type>
+void Work_stealing_deque<Type>::Ring::put( std::int64_t i, Type const &obj ) {
+    slots[i & mask].store( obj, std::memory_order_relaxed );
+}
+
+// Copy the elements with indices f to b - 1 into an array twice the size and publish it
+// The elements keep their unbounded indices, so thieves holding the old array still read
+// the right values from it
+template <typename Type>
+typename Work_stealing_deque<Type>::Ring *Work_stealing_deque<Type>::grow( Ring *r, std::int64_t f, std::int64_t b ) {
+    Ring *bigger = new Ring( static_cast<int>( 2*(r->mask + 1) ) );
+
+    for ( std::int64_t i = f; i < b; ++i ) {
+        bigger->put( i, r->get( i ) );
+    }
+
+    retired.push_back( r );
+    ring.store( bigger, std::memory_order_release );
+
+    return bigger;
+}
+
+#endif